@@ -0,0 +1,301 @@
+/**
+ * @file bench_scheduler.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Host benchmark of the dispatch overhead of Scheduler::run() and tick().
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define BENCH_HAS_CYCLES    (1)
+#endif
+
+/* Systick of the simulated clock, in microseconds */
+static const uint32_t SYSTICK_US = 100;
+
+static volatile uint32_t dispatch_count = 0;
+
+static void benchTask(void)
+{
+    dispatch_count = dispatch_count + 1;
+}
+
+enum Distribution {
+    DIST_FIXED,         /*!< Every task has the same interval, derived from the due ratio */
+    DIST_HARMONIC,      /*!< Powers of two of the fixed interval */
+    DIST_LOG_UNIFORM    /*!< Log-uniform between 100 us and 60 s */
+};
+
+static const char* const DIST_NAMES[] = { "fixed", "harmonic", "log_uniform" };
+static const char* const MODE_NAMES[] = { "linear", "heap", "wheel", "priority", "edf", "bitmap", "array" };
+static const int NUM_MODES = sizeof(MODE_NAMES) / sizeof(MODE_NAMES[0]);
+
+struct Result {
+    double tick_ns;         /*!< tick() between two run() calls, as in an application */
+    double tick_idle_ns;    /*!< tick() with no run() in between, nothing completed */
+    double run_ns;
+    double run_cycles;
+    double dispatches_per_run;
+};
+
+static inline uint64_t readCycles(void)
+{
+#ifdef BENCH_HAS_CYCLES
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static std::vector<Scheduler::Task> makeTable(const uint16_t num_tasks, const Distribution dist, const double due_ratio)
+{
+    std::vector<Scheduler::Task> table;
+    std::mt19937 rng(num_tasks);
+
+    /*  A task released every (1 / due_ratio) ticks is due on that fraction of the runs.
+    *   A ratio of 0 uses an interval far beyond the measured window.
+    */
+    const uint32_t fixed = (due_ratio > 0.0) ? (uint32_t)std::lround(SYSTICK_US / due_ratio) : 0x40000000u;
+
+    for( uint16_t i = 0; i < num_tasks; ++i )
+    {
+        uint32_t interval = fixed;
+
+        if( dist == DIST_HARMONIC && due_ratio > 0.0 )
+        {
+            interval = fixed << (i % 8);
+        }
+        else if( dist == DIST_LOG_UNIFORM )
+        {
+            std::uniform_real_distribution<double> exponent(std::log(100.0), std::log(60e6));
+            interval = (uint32_t)std::exp(exponent(rng));
+        }
+
+        table.push_back(Scheduler::Task(benchTask, interval));
+    }
+
+    return table;
+}
+
+/* Average cost of reading the steady clock, taken off the per-call timings */
+static double clockOverhead(void)
+{
+    static const uint32_t SAMPLES = 100000;
+    double total = 0.0;
+
+    for( uint32_t i = 0; i < SAMPLES; ++i )
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    return total / SAMPLES;
+}
+
+/* Average cost of reading the cycle counter, taken off the per-call cycle counts */
+static double cycleOverhead(void)
+{
+    static const uint32_t SAMPLES = 100000;
+    double total = 0.0;
+
+    for( uint32_t i = 0; i < SAMPLES; ++i )
+    {
+        const uint64_t start = readCycles();
+        total += (double)(readCycles() - start);
+    }
+
+    return total / SAMPLES;
+}
+
+static Result measure(const uint16_t num_tasks, const int mode, const Distribution dist,
+                      const double due_ratio, const uint32_t iterations)
+{
+    std::vector<Scheduler::Task> table = makeTable(num_tasks, dist, due_ratio);
+    std::vector<Scheduler::DispatchEntry> queue(num_tasks);
+    std::vector<uint16_t> order(num_tasks);
+    static Scheduler::TimingWheel<4096> wheel;
+    static Scheduler::ReadyBitmap<4096> bitmap;
+    static Scheduler::ReleaseArray<4096> releases;
+    Scheduler scheduler;
+    Result result;
+
+    bool selected = true;
+    if( mode == 1 )
+        selected = scheduler.useHeapDispatch(queue.data(), num_tasks);
+    else if( mode == 2 )
+        selected = scheduler.useWheelDispatch(wheel);
+    else if( mode == 3 )
+    {
+        Scheduler::assignRateMonotonicPriorities(table.data(), num_tasks);
+        selected = scheduler.usePriorityDispatch(order.data(), num_tasks);
+    }
+    else if( mode == 4 )
+        scheduler.useEdfDispatch();
+    else if( mode == 5 )
+        selected = scheduler.useBitmapDispatch(bitmap);
+    else if( mode == 6 )
+        selected = scheduler.useReleaseArrayDispatch(releases);
+
+    /* A mode that silently fell back to another one would report wrong numbers */
+    if( !selected || !scheduler.init(table.data(), num_tasks, SYSTICK_US) )
+    {
+        std::fprintf(stderr, "cannot set up %s dispatch with %u tasks\n", MODE_NAMES[mode], (unsigned)num_tasks);
+        std::exit(1);
+    }
+
+    /* Warm up, this also runs the first release of every task */
+    for( uint32_t i = 0; i < iterations / 10 + 1; ++i )
+    {
+        scheduler.tick();
+        scheduler.run();
+    }
+
+    /* tick() alone, which does not see any task complete */
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for( uint32_t i = 0; i < iterations; ++i )
+    {
+        scheduler.tick();
+    }
+    result.tick_idle_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    /* Catch up the releases skipped above so they are not counted below */
+    scheduler.run();
+
+    /*  run() once per tick, each timed on its own. The cycles are counted in a
+    *   loop of their own, so that neither measurement includes the other.
+    */
+    const uint32_t dispatches = dispatch_count;
+    double tick_ns = 0.0;
+    double run_ns = 0.0;
+    for( uint32_t i = 0; i < iterations; ++i )
+    {
+        start = std::chrono::steady_clock::now();
+        scheduler.tick();
+        const std::chrono::steady_clock::time_point ticked = std::chrono::steady_clock::now();
+        scheduler.run();
+        const std::chrono::steady_clock::time_point ran = std::chrono::steady_clock::now();
+
+        tick_ns += std::chrono::duration<double, std::nano>(ticked - start).count();
+        run_ns += std::chrono::duration<double, std::nano>(ran - ticked).count();
+    }
+    result.dispatches_per_run = (double)(dispatch_count - dispatches) / iterations;
+
+    double run_cycles = 0.0;
+    for( uint32_t i = 0; i < iterations; ++i )
+    {
+        scheduler.tick();
+        const uint64_t cycles = readCycles();
+        scheduler.run();
+        run_cycles += (double)(readCycles() - cycles);
+    }
+
+    static const double clock_overhead = clockOverhead();
+    static const double cycle_overhead = cycleOverhead();
+    result.tick_ns = std::max(tick_ns / iterations - clock_overhead, 0.0);
+    result.run_ns = std::max(run_ns / iterations - clock_overhead, 0.0);
+    result.run_cycles = std::max(run_cycles / iterations - cycle_overhead, 0.0);
+
+    return result;
+}
+
+static void usage(const char* const name)
+{
+    std::printf("usage: %s [--json] [--max-tasks N] [--iterations N]\n", name);
+}
+
+int main(int argc, char** argv)
+{
+    bool json = false;
+    uint32_t max_tasks = 4096;
+    uint32_t iterations = 10000;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        if( std::strcmp(argv[i], "--json") == 0 )
+            json = true;
+        else if( std::strcmp(argv[i], "--max-tasks") == 0 && i + 1 < argc )
+            max_tasks = (uint32_t)std::strtoul(argv[++i], NULL, 10);
+        else if( std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc )
+            iterations = (uint32_t)std::strtoul(argv[++i], NULL, 10);
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if( max_tasks > 4096 || iterations == 0 )
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    static const double DUE_RATIOS[] = { 0.0, 0.01, 0.1, 1.0 };
+
+    if( !json )
+        std::printf("mode,tasks,distribution,due_ratio,dispatches_per_run,tick_ns,tick_idle_ns,run_ns,run_cycles\n");
+
+    for( uint32_t num_tasks = 1; num_tasks <= max_tasks; num_tasks *= 4 )
+    {
+        for( int mode = 0; mode < NUM_MODES; ++mode )
+        {
+            /* EDF scans the table on every pick, large tables take too long to measure */
+            if( mode == 4 && num_tasks > 256 )
+                continue;
+
+            for( int dist = DIST_FIXED; dist <= DIST_LOG_UNIFORM; ++dist )
+            {
+                for( size_t r = 0; r < sizeof(DUE_RATIOS) / sizeof(DUE_RATIOS[0]); ++r )
+                {
+                    /* The log-uniform table does not depend on the due ratio */
+                    if( dist == DIST_LOG_UNIFORM && r > 0 )
+                        break;
+
+                    const Result res = measure((uint16_t)num_tasks, mode, (Distribution)dist, DUE_RATIOS[r], iterations);
+
+                    std::printf(json ?
+                        "{\"mode\":\"%s\",\"tasks\":%u,\"distribution\":\"%s\",\"due_ratio\":%g,"
+                        "\"dispatches_per_run\":%.4f,\"tick_ns\":%.2f,\"tick_idle_ns\":%.2f,\"run_ns\":%.2f,\"run_cycles\":%.1f}\n" :
+                        "%s,%u,%s,%g,%.4f,%.2f,%.2f,%.2f,%.1f\n",
+                        MODE_NAMES[mode], num_tasks, DIST_NAMES[dist], DUE_RATIOS[r],
+                        res.dispatches_per_run, res.tick_ns, res.tick_idle_ns, res.run_ns, res.run_cycles);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
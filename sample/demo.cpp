@@ -0,0 +1,67 @@
+/**
+ * @file demo.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Host demo of two periodic tasks on a simulated 1 ms systick.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Scheduler.hpp"
+
+#include <cstdio>
+
+/* Systick of the simulated clock, in microseconds */
+static const uint32_t SYSTICK_US = 1000;
+
+static Scheduler scheduler;
+
+static void blink(void)
+{
+    printf("%8lu us  blink\n", (unsigned long)scheduler.getTickCount());
+}
+
+static void report(void)
+{
+    printf("%8lu us  report\n", (unsigned long)scheduler.getTickCount());
+}
+
+static Scheduler::Task tasks[] = {
+    Scheduler::Task(blink, 250000),
+    Scheduler::Task(report, 1000000)
+};
+
+int main(void)
+{
+    if( !scheduler.init(tasks, sizeof(tasks) / sizeof(tasks[0]), SYSTICK_US) )
+        return 1;
+
+    /* Three simulated seconds, tick() stands in for the systick interrupt */
+    for( uint32_t ms = 0; ms < 3000; ++ms )
+    {
+        scheduler.run();
+        scheduler.tick();
+    }
+
+    return 0;
+}
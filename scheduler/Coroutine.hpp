@@ -0,0 +1,140 @@
+/**
+ * @file Coroutine.hpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Stackless coroutines that run as Scheduler tasks.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "Scheduler.hpp"
+
+/* Marks the intended fall through into the resume points */
+#ifndef COROUTINE_FALLTHROUGH
+    #if defined(__has_attribute)
+        #if __has_attribute(fallthrough)
+            #define COROUTINE_FALLTHROUGH   __attribute__((fallthrough))
+        #endif
+    #endif
+#endif
+#ifndef COROUTINE_FALLTHROUGH
+    #define COROUTINE_FALLTHROUGH
+#endif
+
+/**
+ * @brief   Base of a stackless coroutine, protothread style. Derive from it and write
+ *          the body of a task between COROUTINE_BEGIN() and COROUTINE_END(); each run of
+ *          the task resumes the body where it last yielded, so a long operation spreads
+ *          over many run() passes instead of blocking the other tasks.
+ *
+ *          The body is a switch statement: local variables do not survive a yield, keep
+ *          them as members. Use at most one coroutine macro per source line, and no
+ *          switch statement that spans a yield.
+ *
+ * @code
+ * class FlashEraser : public Coroutine {
+ * public:
+ *     void step(void) {
+ *         COROUTINE_BEGIN();
+ *         for( sector_ = 0; sector_ < 8; ++sector_ )
+ *         {
+ *             flashStartErase(sector_);
+ *             COROUTINE_WAIT_UNTIL(flashIsReady());
+ *         }
+ *         COROUTINE_DELAY(scheduler, 100000);
+ *         COROUTINE_END();
+ *     }
+ * private:
+ *     uint8_t sector_;
+ * };
+ *
+ * Scheduler::Task::bind<FlashEraser, &FlashEraser::step>(&eraser, 1000)
+ * @endcode
+ *
+ * The task's interval is the polling period of the waits. Bound as an event task
+ * (see Scheduler::useEventQueue()), COROUTINE_YIELD() waits for the next post().
+ */
+class Coroutine {
+    public:
+        /**
+         * @brief Start the body from COROUTINE_BEGIN() on the next run
+         *
+         */
+        void restart(void) {
+            coroutine_line_ = 0;
+        }
+
+        /**
+         * @brief Whether the body reached COROUTINE_END()
+         *
+         * @return true When finished, until restart()
+         */
+        bool isDone(void) const {
+            return coroutine_line_ == COROUTINE_DONE;
+        }
+
+    protected:
+        static const uint32_t COROUTINE_DONE = UINT32_MAX;     /*!< Resume point of a finished body */
+
+        uint32_t coroutine_line_ = 0;           /*!< Source line to resume at, 0 to start */
+        Scheduler::tick_t coroutine_wake_ = 0;  /*!< Tick awaited by COROUTINE_DELAY() */
+
+        /* Whether the tick counter [now] reached [tick], across wrap-around */
+        static bool isReached(const Scheduler::tick_t now, const Scheduler::tick_t tick) {
+            return (Scheduler::tick_t)(now - tick) < ((Scheduler::tick_t)1 << (sizeof(Scheduler::tick_t) * 8 - 1));
+        }
+};
+
+/* Opens the body, resuming at the last yield */
+#define COROUTINE_BEGIN()                                                   \
+    switch( coroutine_line_ ) { case 0:
+
+/* Returns from the task, the next run continues after it */
+#define COROUTINE_YIELD()                                                   \
+    do { coroutine_line_ = __LINE__; return; case __LINE__: ; } while( 0 )
+
+/* Returns from the task on every run until [condition] holds */
+#define COROUTINE_WAIT_UNTIL(condition)                                     \
+    do { coroutine_line_ = __LINE__; COROUTINE_FALLTHROUGH; case __LINE__:  \
+        if( !(condition) ) return; } while( 0 )
+
+/* Waits until the tick counter of [scheduler] reaches [tick] */
+#define COROUTINE_WAIT_UNTIL_TICK(scheduler, tick)                          \
+    do { coroutine_wake_ = (tick);                                          \
+        COROUTINE_WAIT_UNTIL(isReached((scheduler).getTickCount(), coroutine_wake_)); } while( 0 )
+
+/* Waits for [duration] ticks of [scheduler] */
+#define COROUTINE_DELAY(scheduler, duration)                                \
+    COROUTINE_WAIT_UNTIL_TICK(scheduler, (scheduler).getTickCount() + (duration))
+
+/* Starts the body over on the next run */
+#define COROUTINE_RESTART()                                                 \
+    do { coroutine_line_ = 0; return; } while( 0 )
+
+/* Closes the body, later runs return at once until restart() */
+#define COROUTINE_END()                                                     \
+    coroutine_line_ = COROUTINE_DONE; COROUTINE_FALLTHROUGH; case COROUTINE_DONE: ; } return
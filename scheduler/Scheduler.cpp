@@ -29,36 +29,82 @@
 
 #include "Scheduler.hpp"
 
+typedef Scheduler::tick_t tick_t;
+
+/* Signed difference between two ticks */
+#ifdef SCHEDULER_64BIT_TICK
+typedef int64_t tick_diff_t;
+#else
+typedef int32_t tick_diff_t;
+#endif
+
+/* Wrap-safe ordering of two release ticks */
+static inline bool isBefore(const tick_t a, const tick_t b)
+{
+    return (tick_diff_t)(a - b) < 0;
+}
+
 bool Scheduler::init(Task* const taskTable, const uint16_t num_tasks, const uint32_t systick_interval) {
-    this->systick_interval_ = systick_interval;
     bool retval = false;
 
-    /* Checks for null pointer */
-    if( taskTable == NULL ) return retval;
+    /* Checks for null pointer and for a tick that never advances */
+    if( taskTable == NULL || systick_interval == 0 ) return retval;
+    this->systick_interval_ = systick_interval;
 
-    /* Checks whether the functions are not NULL */
+    /*  Checks whether the functions are not NULL, except in free pool slots,
+    *   and whether the phases fall within the first interval.
+    */
     for( uint16_t i = 0; i < num_tasks; ++i )
     {
-        if( taskTable[i].func == NULL )
+        if( !taskTable[i].hasFunction() && (taskTable[i].state_ & Task::STATE_FREE) == 0 )
             return retval;
+#ifdef SCHEDULER_ENABLE_PHASE
+        if( taskTable[i].phase != 0 && taskTable[i].phase >= taskTable[i].interval )
+            return retval;
+#endif
     }
 
+#ifdef SCHEDULER_HAS_DISPATCH_STORAGE
+    /* Checks whether the dispatch storage can hold the table */
+    if( usesDispatchStorage() && dispatch_capacity_ < num_tasks )
+        return retval;
+#endif
+
     /* Attaches the taskTable and num_tasks to internal variables */
     task_table_ = taskTable;
     num_tasks_ = num_tasks;
 
     /*  Initializes the last_called_ to
-    *   (UINT32_MAX - interval + 1) so that function is called
-    *   on first instance of run().
+    *   (phase - interval) so that function is called
+    *   on first instance of run() after [phase] ticks.
     */
     for( uint16_t i = 0; i < num_tasks; ++i )
     {
-        task_table_[i].last_called_ = UINT32_MAX - task_table_[i].interval + 1;
+#ifdef SCHEDULER_ENABLE_PHASE
+        task_table_[i].last_called_ = task_table_[i].phase - task_table_[i].interval;
+#else
+        task_table_[i].last_called_ = 0 - task_table_[i].interval;
+#endif
     }
 
     /* Initialize system tick counter to zero */
     sys_tick_ctr_ = 0;
 
+    /* Clear the timing fault counters */
+    deadline_miss_count_ = 0;
+#ifdef SCHEDULER_ENABLE_BUDGET
+    budget_overrun_count_ = 0;
+#endif
+    idle_ticks_ = 0;
+
+#ifdef SCHEDULER_ENABLE_LOAD
+    /* Start the first load window */
+    resetLoad();
+#endif
+
+    /* Rebuild the dispatch queue for the new table */
+    buildDispatch();
+
     retval = true;
     return retval;
 }
@@ -68,56 +114,1987 @@ bool Scheduler::init(Task* const taskTable, const uint16_t num_tasks) {
 }
 
 #pragma FUNC_ALWAYS_INLINE
-uint32_t Scheduler::tick(void)
+Scheduler::tick_t Scheduler::tick(void)
+{
+    const tick_t now = sys_tick_ctr_ += systick_interval_;
+#ifdef SCHEDULER_64BIT_TICK
+    ++tick_seq_;
+#endif
+
+#ifdef SCHEDULER_ENABLE_TRACE
+    traceTick();
+#endif
+
+#ifdef SCHEDULER_ENABLE_BITMAP
+    /* Mark the tasks that became due */
+    if( dispatch_mode_ == DISPATCH_BITMAP )
+        updateReady(now);
+#endif
+
+    return now;
+}
+
+bool Scheduler::setTickInterval(const uint32_t systick_interval) {
+    /* A zero interval would stop the clock, and divides getTicksToNextDeadline() */
+    if( systick_interval == 0 ) return false;
+    this->systick_interval_ = systick_interval;
+    return true;
+}
+
+#ifdef SCHEDULER_HAS_CYCLE_COUNTER
+void Scheduler::setCycleCounter(uint32_t (*cycle_counter)(void))
 {
-    return sys_tick_ctr_ += systick_interval_;
+    cycle_counter_ = cycle_counter;
+#ifdef SCHEDULER_ENABLE_LOAD
+    resetLoad();
+#endif
 }
 
-uint32_t Scheduler::getTickCount(void)
+uint32_t Scheduler::readClock(void)
 {
-    return sys_tick_ctr_;
+    return (cycle_counter_ != NULL) ? cycle_counter_() : (uint32_t)getTickCount();
 }
+#endif
 
-void Scheduler::setTickInterval(const uint32_t systick_interval) {
-    this->systick_interval_ = systick_interval;
+#ifdef SCHEDULER_ENABLE_TRACE
+bool Scheduler::useTraceBuffer(TraceEvent* const storage, const uint32_t capacity)
+{
+    if( storage != NULL && (capacity == 0 || (capacity & (capacity - 1)) != 0) )
+        return false;
+
+    trace_storage_ = NULL;
+    SCHEDULER_COMPILER_BARRIER();
+    trace_mask_ = capacity - 1;
+    trace_head_ = 0;
+    trace_deferred_seen_ = trace_deferred_;
+    SCHEDULER_COMPILER_BARRIER();
+    trace_storage_ = storage;
+    return true;
 }
 
-void Scheduler::run(void)
+uint32_t Scheduler::getTraceCount(void)
 {
-    uint32_t sysctr;
+    return trace_head_;
+}
+
+uint32_t Scheduler::copyTrace(TraceEvent* const out, const uint32_t max_events)
+{
+    if( trace_storage_ == NULL || out == NULL )
+        return 0;
+
+    const uint32_t head = trace_head_;
+    uint32_t count = (head > trace_mask_) ? (trace_mask_ + 1) : head;
+    if( count > max_events )
+        count = max_events;
+
+    for( uint32_t i = 0; i < count; ++i )
+        out[i] = trace_storage_[(head - count + i) & trace_mask_];
+
+    return count;
+}
+
+void Scheduler::trace(const uint8_t type, const uint8_t source, const uint16_t task)
+{
+    if( trace_storage_ == NULL )
+        return;
+
+    /*  tick() does not move the head while it is claimed here, it counts a
+    *   deferred tick instead, which is recorded below on its behalf.
+    *   The clock is read under the claim, so that the slots are in timestamp order.
+    */
+    trace_claiming_ = true;
+    SCHEDULER_COMPILER_BARRIER();
+    const uint32_t head = trace_head_;
+    const uint32_t timestamp = readClock();
+    trace_head_ = head + 1;
+    SCHEDULER_COMPILER_BARRIER();
+    trace_claiming_ = false;
+
+    TraceEvent& event = trace_storage_[head & trace_mask_];
+    event.timestamp = timestamp;
+    event.task = task;
+    event.type = type;
+    event.source = source;
+
+    if( trace_deferred_ != trace_deferred_seen_ )
+    {
+        ++trace_deferred_seen_;
+        trace(TRACE_TICK, TRACE_TASK_TABLE, 0);
+    }
+}
+
+void Scheduler::traceTask(const Task& task, const uint8_t type)
+{
+    if( &task >= task_table_ && &task < task_table_ + num_tasks_ )
+        trace(type, TRACE_TASK_TABLE, (uint16_t)(&task - task_table_));
+    else if( &task >= event_tasks_ && &task < event_tasks_ + num_event_tasks_ )
+        trace(type, TRACE_EVENT_TASKS, (uint16_t)(&task - event_tasks_));
+    else
+        trace(type, TRACE_BACKGROUND_TASKS, (uint16_t)(&task - background_tasks_));
+}
+
+void Scheduler::traceTick(void)
+{
+    if( trace_storage_ == NULL )
+        return;
+
+    /* run() is in the middle of moving the head */
+    if( trace_claiming_ )
+    {
+        ++trace_deferred_;
+        return;
+    }
+
+    /* Interrupts run to completion, so nothing moves the head in between */
+    const uint32_t head = trace_head_;
+    trace_head_ = head + 1;
+
+    TraceEvent& event = trace_storage_[head & trace_mask_];
+    event.timestamp = readClock();
+    event.task = 0;
+    event.type = TRACE_TICK;
+    event.source = TRACE_TASK_TABLE;
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_LOAD
+uint16_t Scheduler::getCpuLoad(const LoadWindow window)
+{
+    uint8_t seconds = (window == LOAD_60S) ? 60 : (window == LOAD_10S) ? 10 : 1;
+    if( seconds > load_seconds_ )
+        seconds = load_seconds_;
+    if( seconds == 0 )
+        return 0;
+
+    uint32_t sum = 0;
+    uint8_t index = load_index_;
+    for( uint8_t i = 0; i < seconds; ++i )
+    {
+        index = (index == 0) ? (SCHEDULER_LOAD_HISTORY - 1) : (index - 1);
+        sum += load_history_[index];
+    }
+
+    return (uint16_t)(sum / seconds);
+}
+
+void Scheduler::accountLoad(Task& task, const uint32_t start)
+{
+    const uint32_t busy = readClock() - start;
+    task.load_cycles_ += busy;
+    load_busy_ += busy;
+}
+
+/* Per mille of [part] in [total] */
+static uint16_t perMille(const uint32_t part, const uint64_t total)
+{
+    if( total == 0 )
+        return 0;
+
+    const uint64_t share = (uint64_t)part * 1000 / total;
+    return (share > 1000) ? 1000 : (uint16_t)share;
+}
+
+void Scheduler::updateLoad(void)
+{
+    const tick_t now = getTickCount();
+    const tick_t elapsed = now - load_start_;
+    if( elapsed < SCHEDULER_LOAD_TICKS_PER_SECOND )
+        return;
+
+    /*  Close every second that elapsed, e.g. during a long tickless sleep,
+    *   at the average load over them.
+    */
+    const uint32_t clock = readClock();
+    const tick_t seconds = elapsed / SCHEDULER_LOAD_TICKS_PER_SECOND;
+    uint64_t total = clock - load_start_clock_;
+
+    /*  The clock may wrap during a sleep of several seconds, so such a window
+    *   is measured with the clock rate of the last second that closed on time.
+    */
+    if( seconds == 1 )
+        load_clock_rate_ = (uint32_t)(total * SCHEDULER_LOAD_TICKS_PER_SECOND / elapsed);
+    else if( load_clock_rate_ != 0 )
+        total = (uint64_t)load_clock_rate_ * seconds
+              + (uint64_t)load_clock_rate_ * (elapsed % SCHEDULER_LOAD_TICKS_PER_SECOND) / SCHEDULER_LOAD_TICKS_PER_SECOND;
+
+    const uint16_t load = perMille(load_busy_, total);
+
+    for( tick_t i = 0; i < seconds && i < SCHEDULER_LOAD_HISTORY; ++i )
+    {
+        load_history_[load_index_] = load;
+        load_index_ = (load_index_ + 1) % SCHEDULER_LOAD_HISTORY;
+        if( load_seconds_ < SCHEDULER_LOAD_HISTORY )
+            ++load_seconds_;
+    }
 
-    /* Loop across the tasks */
     for( uint16_t i = 0; i < num_tasks_; ++i )
     {
-        /* obtain a copy of the sys_tick_ctr at the execution to avoid concurrency */
-        sysctr = sys_tick_ctr_;
+        task_table_[i].load = perMille(task_table_[i].load_cycles_, total);
+        task_table_[i].load_cycles_ = 0;
+    }
+    for( uint16_t i = 0; i < num_event_tasks_; ++i )
+    {
+        event_tasks_[i].load = perMille(event_tasks_[i].load_cycles_, total);
+        event_tasks_[i].load_cycles_ = 0;
+    }
 
-        /* Breaks the loop on NULL existence */
-        if( task_table_[i].func == NULL )
-            break;
+    load_busy_ = 0;
+    load_start_ = now;
+    load_start_clock_ = clock;
+}
 
-        /* Run the tasks */
-        if( task_table_[i].interval == 0 )
+void Scheduler::resetLoad(void)
+{
+    load_index_ = 0;
+    load_seconds_ = 0;
+    load_busy_ = 0;
+    load_start_ = getTickCount();
+    load_start_clock_ = readClock();
+    load_clock_rate_ = 0;
+
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        task_table_[i].load = 0;
+        task_table_[i].load_cycles_ = 0;
+    }
+    for( uint16_t i = 0; i < num_event_tasks_; ++i )
+    {
+        event_tasks_[i].load = 0;
+        event_tasks_[i].load_cycles_ = 0;
+    }
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_STATS
+void Scheduler::resetStats(void)
+{
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        task_table_[i].stats.reset();
+    }
+}
+#endif
+
+void Scheduler::setReleasePolicy(const ReleasePolicy policy)
+{
+    release_policy_ = policy;
+}
+
+Scheduler::ReleasePolicy Scheduler::getReleasePolicy(void)
+{
+    return release_policy_;
+}
+
+void Scheduler::setTimingFaultHandler(void (*handler)(Task& task, TimingFault fault))
+{
+    fault_handler_ = handler;
+}
+
+uint32_t Scheduler::getDeadlineMissCount(void)
+{
+    return deadline_miss_count_;
+}
+
+#ifdef SCHEDULER_ENABLE_BUDGET
+uint32_t Scheduler::getBudgetOverrunCount(void)
+{
+    return budget_overrun_count_;
+}
+#endif
+
+Scheduler::tick_t Scheduler::advanceTicks(const uint32_t num_ticks)
+{
+    const tick_t now = sys_tick_ctr_ += (tick_t)num_ticks * systick_interval_;
+#ifdef SCHEDULER_64BIT_TICK
+    ++tick_seq_;
+#endif
+
+#ifdef SCHEDULER_ENABLE_BITMAP
+    /* Mark the tasks that became due */
+    if( dispatch_mode_ == DISPATCH_BITMAP )
+        updateReady(now);
+#endif
+
+    return now;
+}
+
+bool Scheduler::getNextDeadline(tick_t& deadline)
+{
+    tick_t remaining;
+
+    if( !findNextRelease(remaining) )
+        return false;
+
+    deadline = getTickCount() + remaining;
+    return true;
+}
+
+uint32_t Scheduler::getTicksToNextDeadline(void)
+{
+    tick_t remaining;
+
+    if( !findNextRelease(remaining) )
+        return UINT32_MAX;
+
+    /* Round up so that the task is due on wake up */
+    const tick_t ticks = remaining / systick_interval_ + ((remaining % systick_interval_) != 0);
+    return (ticks >= UINT32_MAX) ? (UINT32_MAX - 1) : (uint32_t)ticks;
+}
+
+bool Scheduler::findNextRelease(tick_t& remaining)
+{
+    const tick_t sysctr = getTickCount();
+    bool found = false;
+
+    /* A pending event is due now */
+    if( hasPendingEvents() )
+    {
+        remaining = 0;
+        return true;
+    }
+
+#ifdef SCHEDULER_ENABLE_HEAP
+    /* The heap already has the earliest release on top */
+    if( dispatch_mode_ == DISPATCH_HEAP )
+    {
+        const DispatchEntry* const heap = dispatch_queue_;
+
+        if( continuous_count_ > 0 )
         {
-            /* Run continuous tasks */
-            (*(task_table_[i].func))();
+            remaining = 0;
+            return true;
         }
-        else if ( sysctr - task_table_[i].last_called_ >= task_table_[i].interval )
-        {
-            /* Run the tasks that are already due */
-            (*(task_table_[i].func))();
+        if( heap_size_ == 0 )
+            return false;
 
-            /* Update last_called_.
-             * using sysctr instead of sys_tick_ctr makes sure that
-             * the counter value is the same at the start and end of the function
-             */
-            task_table_[i].last_called_ = sysctr;
-        }
-        else
-        {
-            /* do nothing */
+        remaining = isBefore(sysctr, heap[0].release) ? heap[0].release - sysctr : 0;
+        return true;
+    }
+#endif
+
+    /* Otherwise scan the task table */
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        const Task& task = task_table_[i];
+
+        /* Breaks the loop on NULL existence, as run() does */
+        if( dispatch_mode_ == DISPATCH_LINEAR && !task.hasFunction() && (task.state_ & Task::STATE_FREE) == 0 )
+            break;
+        if( !task.isRunnable() )
+            continue;
+
+        const tick_t elapsed = sysctr - task.last_called_;
+        const tick_t left = (elapsed >= task.interval) ? 0 : task.interval - elapsed;
+
+        if( !found || left < remaining )
+            remaining = left;
+        found = true;
+
+        if( remaining == 0 )
+            break;
+    }
+
+    return found;
+}
+
+void Scheduler::useLinearDispatch(void)
+{
+    dispatch_mode_ = DISPATCH_LINEAR;
+}
+
+#ifdef SCHEDULER_ENABLE_HEAP
+bool Scheduler::useHeapDispatch(DispatchEntry* const storage, const uint16_t capacity)
+{
+    if( storage == NULL || capacity < num_tasks_ )
+        return false;
+
+    dispatch_queue_ = storage;
+    dispatch_capacity_ = capacity;
+    dispatch_mode_ = DISPATCH_HEAP;
+    buildDispatch();
+
+    return true;
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_WHEEL
+bool Scheduler::useWheelDispatch(uint16_t* const slots, uint16_t* const links, const uint16_t capacity)
+{
+    if( slots == NULL || links == NULL || capacity < num_tasks_ || capacity == WHEEL_END )
+        return false;
+
+    wheel_slots_ = slots;
+    wheel_links_ = links;
+    dispatch_capacity_ = capacity;
+    dispatch_mode_ = DISPATCH_WHEEL;
+    buildDispatch();
+
+    return true;
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_PRIORITY
+bool Scheduler::usePriorityDispatch(uint16_t* const order, const uint16_t capacity)
+{
+    if( order == NULL || capacity < num_tasks_ )
+        return false;
+
+    dispatch_order_ = order;
+    dispatch_capacity_ = capacity;
+    dispatch_mode_ = DISPATCH_PRIORITY;
+    buildDispatch();
+
+    return true;
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_BITMAP
+bool Scheduler::useBitmapDispatch(uint32_t* const released, uint32_t* const acknowledged, uint32_t* const scanned,
+                                  const uint16_t num_words, DispatchEntry* const pending, const uint16_t capacity)
+{
+    const uint32_t bits = (uint32_t)num_words * 32;
+
+    if( released == NULL || acknowledged == NULL || scanned == NULL || pending == NULL )
+        return false;
+    if( bits < num_tasks_ || capacity < num_tasks_ )
+        return false;
+
+    ready_released_ = released;
+    ready_acknowledged_ = acknowledged;
+    ready_scanned_ = scanned;
+    ready_pending_ = pending;
+    dispatch_capacity_ = (bits < capacity) ? (uint16_t)bits : capacity;
+    dispatch_mode_ = DISPATCH_BITMAP;
+    buildDispatch();
+
+    return true;
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_RELEASE_ARRAY
+bool Scheduler::useReleaseArrayDispatch(tick_t* const releases, const uint16_t capacity)
+{
+    if( releases == NULL || capacity < num_tasks_ )
+        return false;
+
+    release_array_ = releases;
+    dispatch_capacity_ = capacity;
+    dispatch_mode_ = DISPATCH_RELEASE_ARRAY;
+    buildDispatch();
+
+    return true;
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_EDF
+void Scheduler::useEdfDispatch(void)
+{
+    dispatch_mode_ = DISPATCH_EDF;
+}
+#endif
+
+void Scheduler::buildPool(void)
+{
+    free_head_ = POOL_END;
+
+    /* Push from the end, so that the lowest free slots are handed out first */
+    for( uint16_t i = num_tasks_; i > 0; --i )
+    {
+        Task& task = task_table_[i - 1];
+        task.state_ &= (uint8_t)~Task::STATE_QUEUED;
+
+        if( (task.state_ & Task::STATE_FREE) != 0 )
+            releaseSlot(i - 1);
+    }
+}
+
+void Scheduler::releaseSlot(const uint16_t index)
+{
+    task_table_[index].last_called_ = free_head_;
+    free_head_ = index;
+}
+
+void Scheduler::dropTask(const uint16_t index)
+{
+    Task& task = task_table_[index];
+    task.state_ &= (uint8_t)~Task::STATE_QUEUED;
+
+    /* The slot was removed while queued, it is free from now on */
+    if( (task.state_ & Task::STATE_FREE) != 0 )
+        releaseSlot(index);
+}
+
+void Scheduler::enqueueTask(const uint16_t index)
+{
+    Task& task = task_table_[index];
+
+    if( !task.isActive() )
+        return;
+
+#ifdef SCHEDULER_ENABLE_HEAP
+    if( dispatch_mode_ == DISPATCH_HEAP )
+    {
+        /* Continuous tasks keep their place at the end of the queue */
+        if( (task.state_ & Task::STATE_QUEUED) != 0 || task.interval == 0 )
+            return;
+
+        DispatchEntry* const heap = dispatch_queue_;
+        heap[heap_size_].release = task.last_called_ + task.interval;
+        heap[heap_size_].task = index;
+        siftUp(heap, heap_size_++);
+        task.state_ |= Task::STATE_QUEUED;
+    }
+#endif
+#ifdef SCHEDULER_ENABLE_WHEEL
+    if( dispatch_mode_ == DISPATCH_WHEEL )
+    {
+        if( (task.state_ & Task::STATE_QUEUED) != 0 )
+            return;
+
+        wheelInsert(index);
+        task.state_ |= Task::STATE_QUEUED;
+    }
+#endif
+#ifdef SCHEDULER_ENABLE_BITMAP
+    if( dispatch_mode_ == DISPATCH_BITMAP )
+    {
+        /* Have tick() scan again, the task may be in none of its structures */
+        ready_rescans_ = ready_rescans_ + 1;
+    }
+#endif
+#ifdef SCHEDULER_ENABLE_RELEASE_ARRAY
+    if( dispatch_mode_ == DISPATCH_RELEASE_ARRAY )
+    {
+        release_array_[index] = nextRelease(task, getTickCount());
+    }
+#endif
+}
+
+Scheduler::Task* Scheduler::insertTask(const Task& task, const tick_t release, const uint8_t state)
+{
+    if( free_head_ == POOL_END || !task.hasFunction() || task.interval == 0 )
+        return NULL;
+
+    const uint16_t index = free_head_;
+    Task& slot = task_table_[index];
+    free_head_ = (uint16_t)slot.last_called_;
+#ifdef SCHEDULER_ENABLE_PRIORITY
+    const uint8_t priority = slot.priority;
+#endif
+
+    /*  The slot stays free until its release is written, tick() may read it meanwhile.
+    *   Copying a free task keeps it free throughout the copy.
+    */
+    Task copy = task;
+    copy.state_ = Task::STATE_FREE;
+    copy.last_called_ = release - copy.interval;
+    slot = copy;
+    SCHEDULER_COMPILER_BARRIER();
+    slot.state_ = state;
+
+#ifdef SCHEDULER_ENABLE_PRIORITY
+    if( dispatch_mode_ == DISPATCH_PRIORITY && slot.priority != priority )
+        reorderTask(index);
+#endif
+    enqueueTask(index);
+
+    return &slot;
+}
+
+Scheduler::Task* Scheduler::addTask(const Task& task)
+{
+#ifdef SCHEDULER_ENABLE_PHASE
+    if( task.phase != 0 && task.phase >= task.interval )
+        return NULL;
+
+    /* Due [phase] ticks from now, as after init() */
+    return insertTask(task, getTickCount() + task.phase, 0);
+#else
+    return insertTask(task, getTickCount(), 0);
+#endif
+}
+
+Scheduler::Task* Scheduler::startTimer(void (*func)(), const tick_t delay)
+{
+    /* The interval only sets the release, a delay of 0 is due on the next run() */
+    return insertTask(Task(func, (delay != 0) ? delay : 1), getTickCount() + delay, Task::STATE_ONESHOT);
+}
+
+Scheduler::Task* Scheduler::startTimer(void (*context_func)(void*), void* const context, const tick_t delay)
+{
+    return insertTask(Task(context_func, context, (delay != 0) ? delay : 1), getTickCount() + delay, Task::STATE_ONESHOT);
+}
+
+bool Scheduler::cancelTimer(Task& timer)
+{
+    if( (timer.state_ & Task::STATE_ONESHOT) == 0 )
+        return false;
+
+    return removeTask(timer);
+}
+
+bool Scheduler::removeTask(Task& task)
+{
+    if( &task < task_table_ || &task >= task_table_ + num_tasks_ || (task.state_ & Task::STATE_FREE) != 0 )
+        return false;
+
+    const uint16_t index = (uint16_t)(&task - task_table_);
+    task.state_ |= Task::STATE_FREE;
+
+    /* A slot whose entry run() holds is released when the dispatcher drops it */
+    if( (task.state_ & Task::STATE_QUEUED) == 0 )
+        releaseSlot(index);
+    else if( dequeueTask(index) )
+        dropTask(index);
+
+    return true;
+}
+
+void Scheduler::disableTask(Task& task)
+{
+    task.state_ |= Task::STATE_DISABLED;
+}
+
+void Scheduler::enableTask(Task& task)
+{
+    if( (task.state_ & Task::STATE_DISABLED) == 0 )
+        return;
+
+    /* Publish the new release before tick() may see the task active */
+    task.last_called_ = getTickCount();
+    SCHEDULER_COMPILER_BARRIER();
+    task.state_ &= (uint8_t)~Task::STATE_DISABLED;
+
+    if( &task >= task_table_ && &task < task_table_ + num_tasks_ )
+        enqueueTask((uint16_t)(&task - task_table_));
+}
+
+void Scheduler::suspendTask(Task& task)
+{
+    task.state_ |= Task::STATE_SUSPENDED;
+}
+
+void Scheduler::resumeTask(Task& task)
+{
+    if( (task.state_ & Task::STATE_SUSPENDED) == 0 )
+        return;
+
+    /* Skip the releases that passed while suspended */
+    const tick_t now = getTickCount();
+    const tick_t interval = task.interval;
+    const tick_t release = task.last_called_ + interval;
+    if( interval != 0 && isBefore(release, now) )
+    {
+        const tick_t late = now - release;
+        task.last_called_ += (late + interval - 1) / interval * interval;
+    }
+
+    /* Publish the new release before tick() may see the task active */
+    SCHEDULER_COMPILER_BARRIER();
+    task.state_ &= (uint8_t)~Task::STATE_SUSPENDED;
+
+    if( &task >= task_table_ && &task < task_table_ + num_tasks_ )
+        enqueueTask((uint16_t)(&task - task_table_));
+}
+
+bool Scheduler::dequeueTask(const uint16_t index)
+{
+#ifdef SCHEDULER_ENABLE_HEAP
+    if( dispatch_mode_ == DISPATCH_HEAP )
+    {
+        DispatchEntry* const heap = dispatch_queue_;
+
+        for( uint16_t pos = 0; pos < heap_size_; ++pos )
+        {
+            if( heap[pos].task != index )
+                continue;
+
+            /* The last entry takes its place, then moves either way */
+            heap[pos] = heap[--heap_size_];
+            if( pos < heap_size_ )
+            {
+                siftDown(heap, heap_size_, pos);
+                siftUp(heap, pos);
+            }
+            return true;
+        }
+    }
+#endif
+#ifdef SCHEDULER_ENABLE_WHEEL
+    if( dispatch_mode_ == DISPATCH_WHEEL )
+    {
+        for( uint16_t i = 0; i < SCHEDULER_WHEEL_LEVELS * WHEEL_SLOTS; ++i )
+        {
+            for( uint16_t* link = &wheel_slots_[i]; *link != WHEEL_END; link = &wheel_links_[*link] )
+            {
+                if( *link == index )
+                {
+                    *link = wheel_links_[index];
+                    return true;
+                }
+            }
+        }
+    }
+#endif
+#if !defined(SCHEDULER_ENABLE_HEAP) && !defined(SCHEDULER_ENABLE_WHEEL)
+    (void)index;
+#endif
+
+    /* Continuous heap entries, and the entries run() holds, are dropped by run() */
+    return false;
+}
+
+#ifdef SCHEDULER_ENABLE_PRIORITY
+void Scheduler::assignRateMonotonicPriorities(Task* const taskTable, const uint16_t num_tasks)
+{
+    if( taskTable == NULL )
+        return;
+
+    for( uint16_t i = 0; i < num_tasks; ++i )
+    {
+        const tick_t interval = taskTable[i].interval;
+        uint32_t rank = 0;
+
+        /* Continuous tasks have the lowest priority */
+        if( interval != 0 )
+        {
+            /* Rank among the periodic tasks, counted from the longest interval */
+            for( uint16_t j = 0; j < num_tasks; ++j )
+            {
+                if( taskTable[j].interval == 0 || taskTable[j].interval > interval )
+                    ++rank;
+            }
+            if( num_tasks > 256 )
+                rank = rank * 255 / (num_tasks - 1);
+        }
+
+        taskTable[i].priority = (uint8_t)rank;
+    }
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_PHASE
+/* Greatest common divisor of two intervals */
+static tick_t greatestCommonDivisor(tick_t a, tick_t b)
+{
+    while( b != 0 )
+    {
+        const tick_t rest = a % b;
+        a = b;
+        b = rest;
+    }
+    return a;
+}
+
+/* Whether assignPhaseOffsets() places task [a] before task [b]: shorter interval first, then table order */
+static inline bool isPlacedBefore(const Scheduler::Task* const taskTable, const uint16_t a, const uint16_t b)
+{
+    return taskTable[a].interval < taskTable[b].interval ||
+           (taskTable[a].interval == taskTable[b].interval && a < b);
+}
+
+void Scheduler::assignPhaseOffsets(Task* const taskTable, const uint16_t num_tasks, const tick_t granularity)
+{
+    if( taskTable == NULL )
+        return;
+
+    const tick_t step = (granularity != 0) ? granularity : 1;
+    uint16_t previous = num_tasks;
+
+    for( uint16_t placed = 0; placed < num_tasks; ++placed )
+    {
+        /* Next task by increasing interval, without sorting the table */
+        uint16_t next = num_tasks;
+        for( uint16_t i = 0; i < num_tasks; ++i )
+        {
+            if( (previous == num_tasks || isPlacedBefore(taskTable, previous, i)) &&
+                (next == num_tasks || isPlacedBefore(taskTable, i, next)) )
+                next = i;
+        }
+        previous = next;
+
+        Task& task = taskTable[next];
+        const tick_t interval = task.interval;
+        task.phase = 0;
+
+        /* Continuous tasks and free pool slots have no release to place */
+        if( interval == 0 || !task.hasFunction() )
+            continue;
+
+        /*  The releases of a placed task j meet the ones of this task at phase p
+        *   when p and phase_j are equal modulo gcd(interval, interval_j), so the load
+        *   seen by the candidate phases repeats with the lcm of these divisors.
+        */
+        tick_t period = 1;
+        for( uint16_t j = 0; j < num_tasks; ++j )
+        {
+            if( isPlacedBefore(taskTable, j, next) && taskTable[j].interval != 0 && taskTable[j].hasFunction() )
+            {
+                const tick_t divisor = greatestCommonDivisor(interval, taskTable[j].interval);
+                period = period / greatestCommonDivisor(period, divisor) * divisor;
+            }
+        }
+
+        tick_t best_load = 0;
+        for( tick_t phase = 0; phase < period; phase += step )
+        {
+            tick_t load = 0;
+            for( uint16_t j = 0; j < num_tasks; ++j )
+            {
+                const Task& other = taskTable[j];
+                if( !isPlacedBefore(taskTable, j, next) || other.interval == 0 || !other.hasFunction() )
+                    continue;
+
+                const tick_t divisor = greatestCommonDivisor(interval, other.interval);
+                if( phase % divisor == other.phase % divisor )
+#ifdef SCHEDULER_ENABLE_BUDGET
+                    load += (other.budget != 0) ? other.budget : 1;
+#else
+                    ++load;
+#endif
+            }
+
+            if( phase == 0 || load < best_load )
+            {
+                best_load = load;
+                task.phase = phase;
+            }
+            if( best_load == 0 )
+                break;
+        }
+    }
+}
+#endif
+
+Scheduler::DispatchMode Scheduler::getDispatchMode(void)
+{
+    return dispatch_mode_;
+}
+
+#ifdef SCHEDULER_HAS_DISPATCH_STORAGE
+bool Scheduler::usesDispatchStorage(void)
+{
+    return dispatch_mode_ == DISPATCH_HEAP || dispatch_mode_ == DISPATCH_WHEEL ||
+           dispatch_mode_ == DISPATCH_PRIORITY || dispatch_mode_ == DISPATCH_BITMAP ||
+           dispatch_mode_ == DISPATCH_RELEASE_ARRAY;
+}
+#endif
+
+void Scheduler::buildDispatch(void)
+{
+    buildPool();
+
+    switch( dispatch_mode_ )
+    {
+#ifdef SCHEDULER_ENABLE_HEAP
+        case DISPATCH_HEAP:
+            buildHeap();
+            break;
+#endif
+#ifdef SCHEDULER_ENABLE_WHEEL
+        case DISPATCH_WHEEL:
+            buildWheel();
+            break;
+#endif
+#ifdef SCHEDULER_ENABLE_PRIORITY
+        case DISPATCH_PRIORITY:
+            buildOrder();
+            break;
+#endif
+#ifdef SCHEDULER_ENABLE_BITMAP
+        case DISPATCH_BITMAP:
+            buildBitmap();
+            break;
+#endif
+#ifdef SCHEDULER_ENABLE_RELEASE_ARRAY
+        case DISPATCH_RELEASE_ARRAY:
+            buildReleaseArray();
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+#ifdef SCHEDULER_ENABLE_HEAP
+void Scheduler::buildHeap(void)
+{
+    continuous_count_ = 0;
+    heap_size_ = 0;
+
+    /*  Continuous tasks are placed at the end of the queue, the last one first.
+    *   They are queued as well, so that a removed slot is reused only once runHeap() dropped its entry.
+    */
+    DispatchEntry* const continuous = dispatch_queue_ + dispatch_capacity_ - 1;
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        if( task_table_[i].interval == 0 && (task_table_[i].state_ & Task::STATE_FREE) == 0 )
+        {
+            (continuous - continuous_count_)->release = 0;
+            (continuous - continuous_count_)->task = i;
+            ++continuous_count_;
+            task_table_[i].state_ |= Task::STATE_QUEUED;
+        }
+    }
+
+    /* Periodic tasks fill the heap at the front, keyed on their next release */
+    DispatchEntry* const heap = dispatch_queue_;
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        if( task_table_[i].interval != 0 && task_table_[i].isActive() )
+        {
+            heap[heap_size_].release = task_table_[i].last_called_ + task_table_[i].interval;
+            heap[heap_size_].task = i;
+            ++heap_size_;
+            task_table_[i].state_ |= Task::STATE_QUEUED;
+        }
+    }
+
+    /* Heapify bottom-up */
+    for( uint16_t pos = heap_size_ / 2; pos > 0; --pos )
+    {
+        siftDown(heap, heap_size_, pos - 1);
+    }
+}
+#endif
+
+#if defined(SCHEDULER_ENABLE_HEAP) || defined(SCHEDULER_ENABLE_BITMAP)
+void Scheduler::siftDown(DispatchEntry* const heap, const uint16_t size, uint16_t pos)
+{
+    const DispatchEntry entry = heap[pos];
+
+    for( ;; )
+    {
+        uint32_t child = 2 * (uint32_t)pos + 1;
+        if( child >= size )
+            break;
+
+        /* Pick the earlier of the two children */
+        if( child + 1 < size && isBefore(heap[child + 1].release, heap[child].release) )
+            ++child;
+
+        if( !isBefore(heap[child].release, entry.release) )
+            break;
+
+        heap[pos] = heap[child];
+        pos = (uint16_t)child;
+    }
+
+    heap[pos] = entry;
+}
+
+void Scheduler::siftUp(DispatchEntry* const heap, uint16_t pos)
+{
+    const DispatchEntry entry = heap[pos];
+
+    while( pos > 0 )
+    {
+        const uint16_t parent = (uint16_t)((pos - 1) / 2);
+        if( !isBefore(entry.release, heap[parent].release) )
+            break;
+
+        heap[pos] = heap[parent];
+        pos = parent;
+    }
+
+    heap[pos] = entry;
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_PRIORITY
+void Scheduler::buildOrder(void)
+{
+    /* Stable insertion sort by decreasing priority, ties keep table order */
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        const uint8_t priority = task_table_[i].priority;
+        uint16_t pos = i;
+
+        while( pos > 0 && task_table_[dispatch_order_[pos - 1]].priority < priority )
+        {
+            dispatch_order_[pos] = dispatch_order_[pos - 1];
+            --pos;
+        }
+        dispatch_order_[pos] = i;
+    }
+}
+
+/* Whether task [a] runs before task [b] in priority order */
+static inline bool isHigherPriority(const Scheduler::Task* const table, const uint16_t a, const uint16_t b)
+{
+    return table[a].priority > table[b].priority || (table[a].priority == table[b].priority && a < b);
+}
+
+void Scheduler::reorderTask(const uint16_t index)
+{
+    uint16_t pos = 0;
+    while( dispatch_order_[pos] != index )
+        ++pos;
+
+    /* Move the slot towards the front or the back, to its place among the sorted others */
+    while( pos > 0 && isHigherPriority(task_table_, index, dispatch_order_[pos - 1]) )
+    {
+        dispatch_order_[pos] = dispatch_order_[pos - 1];
+        --pos;
+    }
+    while( pos + 1 < num_tasks_ && isHigherPriority(task_table_, dispatch_order_[pos + 1], index) )
+    {
+        dispatch_order_[pos] = dispatch_order_[pos + 1];
+        ++pos;
+    }
+    dispatch_order_[pos] = index;
+}
+#endif
+
+/* Portable fallback when no count-trailing-zeros intrinsic is known */
+#ifndef SCHEDULER_CTZ
+static inline uint8_t countTrailingZeros(uint32_t word)
+{
+    uint8_t count = 0;
+    while( (word & 1u) == 0 )
+    {
+        word >>= 1;
+        ++count;
+    }
+    return count;
+}
+    #define SCHEDULER_CTZ(x)    countTrailingZeros(x)
+#endif
+
+#ifdef SCHEDULER_ENABLE_BITMAP
+void Scheduler::buildBitmap(void)
+{
+    const uint16_t num_words = (uint16_t)((num_tasks_ + 31) / 32);
+
+    for( uint16_t w = 0; w < num_words; ++w )
+    {
+        ready_released_[w] = 0;
+        ready_acknowledged_[w] = 0;
+    }
+
+    /* Mark the tasks that are already due */
+    ready_rescanned_ = ready_rescans_;
+    rescanReady(getTickCount());
+}
+
+void Scheduler::updateReady(const tick_t now)
+{
+    /* The task pool changed, evaluate every task */
+    const uint32_t rescans = ready_rescans_;
+    if( rescans != ready_rescanned_ )
+    {
+        ready_rescanned_ = rescans;
+        rescanReady(now);
+        return;
+    }
+
+    /* Evaluate only the tasks that run() acknowledged since the last scan */
+    const uint32_t runs = ready_runs_;
+    if( runs != ready_seen_ )
+    {
+        ready_seen_ = runs;
+
+        const uint16_t num_words = (uint16_t)((num_tasks_ + 31) / 32);
+        for( uint16_t w = 0; w < num_words; ++w )
+        {
+            uint32_t acknowledged = ready_acknowledged_[w] ^ ready_scanned_[w];
+            ready_scanned_[w] ^= acknowledged;
+
+            while( acknowledged != 0 )
+            {
+                releaseReady((uint16_t)(w * 32 + SCHEDULER_CTZ(acknowledged)), now);
+                acknowledged &= acknowledged - 1;
+            }
+        }
+    }
+
+    /* Release the pending tasks that became due, earliest first */
+    while( ready_pending_size_ > 0 && !isBefore(now, ready_pending_[0].release) )
+    {
+        const uint16_t index = ready_pending_[0].task;
+        ready_pending_[0] = ready_pending_[--ready_pending_size_];
+        siftDown(ready_pending_, ready_pending_size_, 0);
+        releaseReady(index, now);
+    }
+}
+
+void Scheduler::rescanReady(const tick_t now)
+{
+    const uint16_t num_words = (uint16_t)((num_tasks_ + 31) / 32);
+
+    ready_seen_ = ready_runs_;
+    ready_pending_size_ = 0;
+
+    for( uint16_t w = 0; w < num_words; ++w )
+        ready_scanned_[w] = ready_acknowledged_[w];
+
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        /* Skip the tasks that are already ready, run() owns them until acknowledged */
+        if( ((ready_released_[i / 32] ^ ready_scanned_[i / 32]) & (1u << (i % 32))) == 0 )
+            releaseReady(i, now);
+    }
+}
+
+void Scheduler::releaseReady(const uint16_t index, const tick_t now)
+{
+    const Task& task = task_table_[index];
+
+    /* Stopped tasks are evaluated again when the task pool asks for a rescan */
+    if( !task.isRunnable() )
+        return;
+
+    /* Mark the task ready, or keep it in the heap of pending releases */
+    const tick_t release = task.last_called_ + task.interval;
+    if( now - task.last_called_ >= task.interval )
+    {
+        ready_released_[index / 32] ^= (1u << (index % 32));
+    }
+    else
+    {
+        ready_pending_[ready_pending_size_].release = release;
+        ready_pending_[ready_pending_size_].task = index;
+        siftUp(ready_pending_, ready_pending_size_++);
+    }
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_RELEASE_ARRAY
+Scheduler::tick_t Scheduler::nextRelease(const Task& task, const tick_t now)
+{
+    /*  Stopped tasks and free slots are parked half the tick range away,
+    *   they are parked again if they are still stopped when reached.
+    */
+    if( !task.isRunnable() )
+        return now + ((tick_t)-1 >> 1);
+
+    /* Continuous tasks are due again on the next run() */
+    return (task.interval == 0) ? now : task.last_called_ + task.interval;
+}
+
+void Scheduler::buildReleaseArray(void)
+{
+    const tick_t now = getTickCount();
+
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+        release_array_[i] = nextRelease(task_table_[i], now);
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_WHEEL
+static const uint32_t WHEEL_MASK = Scheduler::WHEEL_SLOTS - 1;
+
+void Scheduler::buildWheel(void)
+{
+    /* Widest power-of-two slot that is not wider than a systick */
+    wheel_shift_ = 0;
+    while( wheel_shift_ < 31 && (2u << wheel_shift_) <= systick_interval_ )
+        ++wheel_shift_;
+
+    wheel_time_ = getTickCount();
+    wheel_now_ = 0;
+
+    for( uint16_t i = 0; i < SCHEDULER_WHEEL_LEVELS * WHEEL_SLOTS; ++i )
+    {
+        wheel_slots_[i] = WHEEL_END;
+    }
+
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        if( task_table_[i].isActive() )
+        {
+            wheelInsert(i);
+            task_table_[i].state_ |= Task::STATE_QUEUED;
+        }
+    }
+}
+
+void Scheduler::wheelInsert(const uint16_t task)
+{
+    const Task& t = task_table_[task];
+    const tick_diff_t delta_ticks = (tick_diff_t)(t.last_called_ + t.interval - wheel_time_);
+
+    /*  Slots from the current one.
+    *   Continuous tasks and releases in the past go to the current slot.
+    */
+    const tick_t ahead = (t.interval != 0 && delta_ticks > 0) ? ((tick_t)delta_ticks >> wheel_shift_) : 0;
+    uint32_t delta = (ahead > UINT32_MAX) ? UINT32_MAX : (uint32_t)ahead;
+
+    /* Pick the lowest level that can hold the release */
+    uint8_t level = 0;
+    while( level < SCHEDULER_WHEEL_LEVELS - 1 && (delta >> ((level + 1) * SCHEDULER_WHEEL_SLOT_BITS)) != 0 )
+        ++level;
+
+    /* Releases beyond the wheel span park in the farthest top-level slot and cascade later */
+    if( (delta >> (level * SCHEDULER_WHEEL_SLOT_BITS)) > WHEEL_MASK )
+        delta = WHEEL_MASK << (level * SCHEDULER_WHEEL_SLOT_BITS);
+
+    const uint32_t expiry = wheel_now_ + delta;
+    uint16_t* const slot = &wheel_slots_[level * WHEEL_SLOTS + ((expiry >> (level * SCHEDULER_WHEEL_SLOT_BITS)) & WHEEL_MASK)];
+
+    wheel_links_[task] = *slot;
+    *slot = task;
+}
+
+void Scheduler::wheelCollect(uint16_t* const slot, uint16_t& list)
+{
+    uint16_t task = *slot;
+    *slot = WHEEL_END;
+
+    while( task != WHEEL_END )
+    {
+        const uint16_t next = wheel_links_[task];
+        wheel_links_[task] = list;
+        list = task;
+        task = next;
+    }
+}
+
+void Scheduler::wheelSkip(const tick_t num_slots)
+{
+    uint16_t queued = WHEEL_END;
+
+    for( uint16_t i = 0; i < SCHEDULER_WHEEL_LEVELS * WHEEL_SLOTS; ++i )
+        wheelCollect(&wheel_slots_[i], queued);
+
+    /*  Move to the current slot at once. The releases that passed meanwhile
+    *   are re-inserted into it, the others keep their place ahead.
+    */
+    wheel_time_ += num_slots << wheel_shift_;
+    wheel_now_ += (uint32_t)num_slots;
+
+    while( queued != WHEEL_END )
+    {
+        const uint16_t task = queued;
+        queued = wheel_links_[task];
+        wheelInsert(task);
+    }
+}
+
+void Scheduler::wheelCascade(uint16_t* const slot)
+{
+    uint16_t task = *slot;
+    *slot = WHEEL_END;
+
+    while( task != WHEEL_END )
+    {
+        const uint16_t next = wheel_links_[task];
+        wheelInsert(task);
+        task = next;
+    }
+}
+#endif
+
+void Scheduler::dispatch(Task& task, const tick_t sysctr)
+{
+    /* Release served by this run */
+    const tick_t interval = task.interval;
+    tick_t release = task.last_called_ + interval;
+
+    /*  Software timers run once, their slot is marked free before the call so that
+    *   the callback cannot cancel it, and handed back to the pool after it.
+    */
+    const bool oneshot = (task.state_ & Task::STATE_ONESHOT) != 0;
+    const bool periodic = (interval != 0 && !oneshot);
+    if( oneshot )
+        task.state_ |= Task::STATE_FREE;
+
+    /* Phase-locked policies that do not run every missed release */
+    if( periodic && release_policy_ != RELEASE_FREE_RUNNING && release_policy_ != RELEASE_RUN_ALL_MISSED )
+    {
+        const tick_t late = sysctr - release;
+        if( late >= interval )
+        {
+            /* Move to the most recent release on the phase grid */
+            release += late - (late % interval);
+
+            if( release_policy_ == RELEASE_SKIP_MISSED )
+            {
+                task.last_called_ = release;
+                reportFault(task, FAULT_DEADLINE_MISS);
+                return;
+            }
+        }
+    }
+
+#ifdef SCHEDULER_ENABLE_STATS
+    TaskStats& stats = task.stats;
+    const uint32_t start = (cycle_counter_ != NULL) ? cycle_counter_() : 0;
+
+    /* Delay between the release and the start of the task */
+    if( interval != 0 && sysctr - release > stats.max_jitter )
+        stats.max_jitter = sysctr - release;
+#endif
+
+#ifdef SCHEDULER_ENABLE_LOAD
+    const uint32_t load_start = readClock();
+#endif
+
+#ifdef SCHEDULER_ENABLE_TRACE
+    traceTask(task, TRACE_TASK_START);
+#endif
+
+    task.call();
+    ++dispatch_count_;
+
+#ifdef SCHEDULER_ENABLE_TRACE
+    traceTask(task, TRACE_TASK_END);
+#endif
+
+#ifdef SCHEDULER_ENABLE_LOAD
+    accountLoad(task, load_start);
+#endif
+
+    const tick_t end = getTickCount();
+    const bool missed = (periodic && end - release > task.relativeDeadline());
+#ifdef SCHEDULER_ENABLE_BUDGET
+    const bool overran = (task.budget != 0 && end - sysctr > task.budget);
+#endif
+
+#ifdef SCHEDULER_ENABLE_STATS
+    recordRuntime(stats, start);
+
+    /* The task spanned a whole interval of system ticks */
+    if( periodic && end - sysctr >= interval )
+        ++stats.overrun_count;
+    if( missed )
+        ++stats.deadline_miss_count;
+
+    ++stats.run_count;
+#endif
+
+    /*  Update last_called_.
+    *   using sysctr instead of sys_tick_ctr makes sure that
+    *   the counter value is the same at the start and end of the function
+    */
+    if( interval != 0 )
+        task.last_called_ = (release_policy_ == RELEASE_FREE_RUNNING) ? sysctr : release;
+
+    if( missed )
+        reportFault(task, FAULT_DEADLINE_MISS);
+#ifdef SCHEDULER_ENABLE_BUDGET
+    if( overran )
+        reportFault(task, FAULT_BUDGET_OVERRUN);
+#endif
+
+    /* A queued timer is handed back when the dispatcher drops its entry */
+    if( oneshot && (task.state_ & Task::STATE_QUEUED) == 0 )
+        releaseSlot((uint16_t)(&task - task_table_));
+}
+
+#ifdef SCHEDULER_ENABLE_STATS
+void Scheduler::recordRuntime(TaskStats& stats, const uint32_t start)
+{
+    if( cycle_counter_ == NULL )
+        return;
+
+    const uint32_t runtime = cycle_counter_() - start;
+    if( runtime < stats.min_runtime )
+        stats.min_runtime = runtime;
+    if( runtime > stats.max_runtime )
+        stats.max_runtime = runtime;
+    stats.total_runtime += runtime;
+}
+#endif
+
+void Scheduler::dispatchUntimed(Task& task, const tick_t sysctr)
+{
+#ifdef SCHEDULER_ENABLE_STATS
+    const uint32_t start = (cycle_counter_ != NULL) ? cycle_counter_() : 0;
+#endif
+
+#ifdef SCHEDULER_ENABLE_LOAD
+    const uint32_t load_start = readClock();
+#endif
+
+#ifdef SCHEDULER_ENABLE_TRACE
+    traceTask(task, TRACE_TASK_START);
+#endif
+
+    task.call();
+    ++dispatch_count_;
+
+#ifdef SCHEDULER_ENABLE_TRACE
+    traceTask(task, TRACE_TASK_END);
+#endif
+
+#ifdef SCHEDULER_ENABLE_LOAD
+    /* Background tasks only fill idle time, so they count as idle */
+    if( &task >= event_tasks_ && &task < event_tasks_ + num_event_tasks_ )
+        accountLoad(task, load_start);
+#endif
+
+#ifdef SCHEDULER_ENABLE_BUDGET
+    const bool overran = (task.budget != 0 && getTickCount() - sysctr > task.budget);
+#else
+    (void)sysctr;
+#endif
+
+#ifdef SCHEDULER_ENABLE_STATS
+    recordRuntime(task.stats, start);
+    ++task.stats.run_count;
+#endif
+
+#ifdef SCHEDULER_ENABLE_BUDGET
+    if( overran )
+        reportFault(task, FAULT_BUDGET_OVERRUN);
+#endif
+}
+
+void Scheduler::reportFault(Task& task, const TimingFault fault)
+{
+    if( fault == FAULT_DEADLINE_MISS )
+        ++deadline_miss_count_;
+#ifdef SCHEDULER_ENABLE_BUDGET
+    else
+        ++budget_overrun_count_;
+#endif
+
+#ifdef SCHEDULER_ENABLE_TRACE
+    traceTask(task, (fault == FAULT_DEADLINE_MISS) ? TRACE_DEADLINE_MISS : TRACE_BUDGET_OVERRUN);
+#endif
+
+    if( fault_handler_ != NULL )
+        (*fault_handler_)(task, fault);
+}
+
+void Scheduler::run(void)
+{
+    const uint32_t dispatched = dispatch_count_;
+
+    /* Events first, their latency is bounded by one task run */
+    runEvents();
+
+    switch( dispatch_mode_ )
+    {
+#ifdef SCHEDULER_ENABLE_HEAP
+        case DISPATCH_HEAP:
+            runHeap();
+            break;
+#endif
+#ifdef SCHEDULER_ENABLE_WHEEL
+        case DISPATCH_WHEEL:
+            runWheel();
+            break;
+#endif
+#ifdef SCHEDULER_ENABLE_PRIORITY
+        case DISPATCH_PRIORITY:
+            runPriority();
+            break;
+#endif
+#ifdef SCHEDULER_ENABLE_EDF
+        case DISPATCH_EDF:
+            runEdf();
+            break;
+#endif
+#ifdef SCHEDULER_ENABLE_BITMAP
+        case DISPATCH_BITMAP:
+            runBitmap();
+            break;
+#endif
+#ifdef SCHEDULER_ENABLE_RELEASE_ARRAY
+        case DISPATCH_RELEASE_ARRAY:
+            runReleaseArray();
+            break;
+#endif
+        default:
+            runLinear();
+            break;
+    }
+
+    if( dispatch_count_ == dispatched )
+        runIdle();
+
+#ifdef SCHEDULER_ENABLE_LOAD
+    updateLoad();
+#endif
+}
+
+void Scheduler::runIdle(void)
+{
+    const tick_t start = getTickCount();
+
+    /* Each budget starts when its own task starts, not with the pass */
+    for( uint16_t i = 0; i < num_background_tasks_; ++i )
+    {
+        if( background_tasks_[i].isActive() )
+            dispatchUntimed(background_tasks_[i], getTickCount());
+    }
+
+    if( idle_hook_ != NULL )
+        (*idle_hook_)();
+
+    /* Background tasks are pending work, so do not sleep */
+    if( sleep_handler_ != NULL && num_background_tasks_ == 0 )
+        (*sleep_handler_)(getTicksToNextDeadline());
+
+    idle_ticks_ += getTickCount() - start;
+}
+
+bool Scheduler::useEventQueue(Task* const eventTasks, const uint16_t num_event_tasks, uint16_t* const storage, const uint16_t capacity)
+{
+    if( eventTasks == NULL || storage == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0 )
+        return false;
+
+    for( uint16_t i = 0; i < num_event_tasks; ++i )
+    {
+        if( !eventTasks[i].hasFunction() )
+            return false;
+    }
+
+    event_tasks_ = eventTasks;
+    num_event_tasks_ = num_event_tasks;
+    event_storage_ = storage;
+    event_mask_ = capacity - 1;
+    event_head_ = 0;
+    event_tail_ = 0;
+    event_overflow_count_ = 0;
+    return true;
+}
+
+bool Scheduler::post(const uint16_t event_task)
+{
+    if( event_task >= num_event_tasks_ )
+        return false;
+
+    const uint16_t head = event_head_;
+
+    /* Free-running indices, so the fill level survives their wrap-around */
+    if( (uint16_t)(head - event_tail_) > event_mask_ )
+    {
+        ++event_overflow_count_;
+        return false;
+    }
+
+    event_storage_[head & event_mask_] = event_task;
+
+    /* Publish the entry before the new head */
+    SCHEDULER_COMPILER_BARRIER();
+    event_head_ = head + 1;
+    return true;
+}
+
+bool Scheduler::useBackgroundTasks(Task* const backgroundTasks, const uint16_t num_background_tasks)
+{
+    if( num_background_tasks != 0 && backgroundTasks == NULL )
+        return false;
+
+    for( uint16_t i = 0; i < num_background_tasks; ++i )
+    {
+        if( !backgroundTasks[i].hasFunction() )
+            return false;
+    }
+
+    background_tasks_ = backgroundTasks;
+    num_background_tasks_ = num_background_tasks;
+    return true;
+}
+
+void Scheduler::setIdleHook(void (*idle_hook)(void))
+{
+    idle_hook_ = idle_hook;
+}
+
+void Scheduler::setSleepHandler(void (*sleep_handler)(uint32_t ticks))
+{
+    sleep_handler_ = sleep_handler;
+}
+
+bool Scheduler::isIdle(void)
+{
+    tick_t remaining;
+    return !findNextRelease(remaining) || remaining != 0;
+}
+
+Scheduler::tick_t Scheduler::getIdleTicks(void)
+{
+    return idle_ticks_;
+}
+
+uint32_t Scheduler::getEventOverflowCount(void)
+{
+    return event_overflow_count_;
+}
+
+bool Scheduler::hasPendingEvents(void)
+{
+    return event_head_ != event_tail_;
+}
+
+void Scheduler::runEvents(void)
+{
+    /* Only the events posted so far, so that a busy interrupt cannot starve the tasks */
+    const uint16_t head = event_head_;
+    uint16_t tail = event_tail_;
+
+    if( head == tail )
+        return;
+
+    SCHEDULER_COMPILER_BARRIER();
+
+    while( tail != head )
+    {
+        const uint16_t task = event_storage_[tail & event_mask_];
+
+        /* Hand the entry back before running, so the task can be posted again */
+        SCHEDULER_COMPILER_BARRIER();
+        event_tail_ = ++tail;
+
+        /* Each budget starts when its own task starts, not with the batch */
+        if( event_tasks_[task].isActive() )
+            dispatchUntimed(event_tasks_[task], getTickCount());
+    }
+}
+
+#ifdef SCHEDULER_ENABLE_HEAP
+void Scheduler::runHeap(void)
+{
+    tick_t sysctr;
+    DispatchEntry* const heap = dispatch_queue_;
+    DispatchEntry* const continuous = dispatch_queue_ + dispatch_capacity_ - 1;
+
+    /* Run continuous tasks */
+    for( uint16_t i = 0; i < continuous_count_; )
+    {
+        const uint16_t index = (continuous - i)->task;
+        Task& task = task_table_[index];
+
+        /* Drop removed tasks, the last entry takes their place */
+        if( (task.state_ & Task::STATE_FREE) != 0 )
+        {
+            *(continuous - i) = *(continuous - --continuous_count_);
+            dropTask(index);
+            continue;
+        }
+
+        if( task.isRunnable() )
+            dispatch(task, getTickCount());
+        ++i;
+    }
+
+    /*  Pop the due tasks from the top of the heap to the end of the storage.
+    *   Each periodic task is visited at most once per call so that a zero, tiny or backlogged
+    *   interval cannot starve the loop. Popped tasks keep STATE_QUEUED, so their slots are not
+    *   reused meanwhile, and the heap grows back over the popped entries already visited.
+    *   The popped entries sit right below the continuous ones.
+    */
+    DispatchEntry* popped = continuous + 1 - continuous_count_;
+    uint16_t num_popped = 0;
+
+    /* obtain a copy of the sys_tick_ctr at the execution to avoid concurrency */
+    sysctr = getTickCount();
+
+    while( heap_size_ > 0 && !isBefore(sysctr, heap[0].release) )
+    {
+        const DispatchEntry entry = heap[0];
+        heap[0] = heap[--heap_size_];
+        siftDown(heap, heap_size_, 0);
+        *--popped = entry;
+        ++num_popped;
+    }
+
+    /* Visit them in release order */
+    for( uint16_t k = 0; k < num_popped / 2; ++k )
+    {
+        const DispatchEntry entry = popped[k];
+        popped[k] = popped[num_popped - 1 - k];
+        popped[num_popped - 1 - k] = entry;
+    }
+
+    for( uint16_t k = 0; k < num_popped; ++k )
+    {
+        DispatchEntry entry = popped[k];
+        Task& task = task_table_[entry.task];
+
+        /* Drop tasks whose function was cleared, or that were stopped */
+        if( !task.isRunnable() )
+        {
+            dropTask(entry.task);
+            continue;
+        }
+
+        /* Run the task unless its release moved later, e.g. when it was enabled again */
+        sysctr = getTickCount();
+        if( !isBefore(sysctr, task.last_called_ + task.interval) )
+            dispatch(task, sysctr);
+
+        /* Hand a timer that ran, or a task removed by its function, back to the pool */
+        if( (task.state_ & Task::STATE_FREE) != 0 )
+        {
+            dropTask(entry.task);
+            continue;
+        }
+
+        /* Re-key the task on its next release */
+        entry.release = task.last_called_ + task.interval;
+        heap[heap_size_] = entry;
+        siftUp(heap, heap_size_++);
+    }
+}
+#endif
+
+void Scheduler::runLinear(void)
+{
+    tick_t sysctr;
+
+    /* Loop across the tasks */
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        /* obtain a copy of the sys_tick_ctr at the execution to avoid concurrency */
+        sysctr = getTickCount();
+
+        /* Breaks the loop on NULL existence */
+        if( !task_table_[i].hasFunction() && (task_table_[i].state_ & Task::STATE_FREE) == 0 )
+            break;
+
+        /* Skip free slots and stopped tasks */
+        if( !task_table_[i].isActive() )
+            continue;
+
+        /* Run the tasks */
+        if( task_table_[i].interval == 0 )
+        {
+            /* Run continuous tasks */
+            dispatch(task_table_[i], sysctr);
+        }
+        else if ( sysctr - task_table_[i].last_called_ >= task_table_[i].interval )
+        {
+            /* Run the tasks that are already due */
+            dispatch(task_table_[i], sysctr);
+        }
+        else
+        {
+            /* do nothing */
+            continue;
+        }
+
+    }
+}
+
+#ifdef SCHEDULER_ENABLE_PRIORITY
+void Scheduler::runPriority(void)
+{
+    tick_t sysctr;
+
+    /* Loop across the tasks, highest priority first */
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        Task& task = task_table_[dispatch_order_[i]];
+
+        /* obtain a copy of the sys_tick_ctr at the execution to avoid concurrency */
+        sysctr = getTickCount();
+
+        /* Skip tasks whose function was cleared, or that were stopped */
+        if( !task.isRunnable() )
+            continue;
+
+        /* Run continuous tasks and the tasks that are already due */
+        if( task.interval == 0 || sysctr - task.last_called_ >= task.interval )
+            dispatch(task, sysctr);
+    }
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_EDF
+void Scheduler::runEdf(void)
+{
+    tick_t sysctr;
+
+    /*  Each pick runs the due task with the nearest absolute deadline.
+    *   At most one pick per task per call, so that backlogged tasks cannot starve the loop.
+    */
+    uint16_t num_picked = 0;
+    for( ; num_picked < num_tasks_; ++num_picked )
+    {
+        Task* earliest = NULL;
+        tick_t earliest_deadline = 0;
+
+        /* obtain a copy of the sys_tick_ctr at the execution to avoid concurrency */
+        sysctr = getTickCount();
+
+        for( uint16_t i = 0; i < num_tasks_; ++i )
+        {
+            Task& task = task_table_[i];
+
+            if( task.interval == 0 || !task.isRunnable() || (task.state_ & Task::STATE_PICKED) != 0 )
+                continue;
+            if( sysctr - task.last_called_ < task.interval )
+                continue;
+
+            const tick_t release = task.last_called_ + task.interval;
+            const tick_t deadline = release + task.relativeDeadline();
+
+            if( earliest == NULL || isBefore(deadline, earliest_deadline) )
+            {
+                earliest = &task;
+                earliest_deadline = deadline;
+            }
+        }
+
+        if( earliest == NULL )
+            break;
+
+        earliest->state_ |= Task::STATE_PICKED;
+        dispatch(*earliest, sysctr);
+    }
+
+    /* Clear the picks for the next call */
+    for( uint16_t i = 0; num_picked > 0 && i < num_tasks_; ++i )
+    {
+        task_table_[i].state_ &= (uint8_t)~Task::STATE_PICKED;
+    }
+
+    /* Run continuous tasks */
+    for( uint16_t i = 0; i < num_tasks_; ++i )
+    {
+        Task& task = task_table_[i];
+
+        if( task.interval == 0 && task.isRunnable() )
+            dispatch(task, getTickCount());
+    }
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_BITMAP
+void Scheduler::runBitmap(void)
+{
+    tick_t sysctr;
+    const uint16_t num_words = (uint16_t)((num_tasks_ + 31) / 32);
+
+    for( uint16_t w = 0; w < num_words; ++w )
+    {
+        uint32_t ready = ready_released_[w] ^ ready_acknowledged_[w];
+
+        while( ready != 0 )
+        {
+            const uint8_t bit = SCHEDULER_CTZ(ready);
+            const uint16_t i = (uint16_t)(w * 32 + bit);
+            Task& task = task_table_[i];
+            ready &= ready - 1;
+
+            /* obtain a copy of the sys_tick_ctr at the execution to avoid concurrency */
+            sysctr = getTickCount();
+
+            if( task.isRunnable() )
+            {
+                dispatch(task, sysctr);
+
+                /* Continuous tasks stay ready */
+                if( task.interval == 0 )
+                    continue;
+            }
+
+            /* Publish the new release before handing the task back to tick() */
+            SCHEDULER_COMPILER_BARRIER();
+            ready_acknowledged_[w] ^= (1u << bit);
+            ready_runs_ = ready_runs_ + 1;
+        }
+    }
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_RELEASE_ARRAY
+void Scheduler::runReleaseArray(void)
+{
+    tick_t sysctr = getTickCount();
+
+    for( uint16_t base = 0; base < num_tasks_; base += 32 )
+    {
+        const tick_t* const releases = release_array_ + base;
+        const uint32_t count = (num_tasks_ - base < 32) ? (uint32_t)(num_tasks_ - base) : 32;
+        uint32_t due = 0;
+
+        /*  Branch-free over the contiguous releases only, so that it can be vectorized
+        *   on targets with per-lane shifts (e.g. NEON, AVX2).
+        */
+        for( uint32_t b = 0; b < count; ++b )
+            due |= (uint32_t)((tick_diff_t)(sysctr - releases[b]) >= 0) << b;
+
+        while( due != 0 )
+        {
+            const uint16_t i = (uint16_t)(base + SCHEDULER_CTZ(due));
+            Task& task = task_table_[i];
+            due &= due - 1;
+
+            /* obtain a copy of the sys_tick_ctr at the execution to avoid concurrency */
+            sysctr = getTickCount();
+
+            /* The interval may have grown since the release was stored */
+            if( task.isRunnable() && sysctr - task.last_called_ >= task.interval )
+                dispatch(task, sysctr);
+
+            release_array_[i] = nextRelease(task, sysctr);
+        }
+    }
+}
+#endif
+
+#ifdef SCHEDULER_ENABLE_WHEEL
+void Scheduler::runWheel(void)
+{
+    tick_t sysctr = getTickCount();
+    const tick_t width = (tick_t)1 << wheel_shift_;
+    uint16_t expired = WHEEL_END;
+
+    /* After a long gap, e.g. a tickless sleep, re-inserting every task is cheaper than walking the slots */
+    const tick_t elapsed = (sysctr - wheel_time_) >> wheel_shift_;
+    if( elapsed > (tick_t)SCHEDULER_WHEEL_LEVELS * WHEEL_SLOTS + num_tasks_ )
+        wheelSkip(elapsed);
+
+    /*  Collect every slot that has fully elapsed before running anything,
+    *   so that a task re-inserted during catch-up is not visited twice.
+    */
+    while( sysctr - wheel_time_ >= width )
+    {
+        wheelCollect(&wheel_slots_[wheel_now_ & WHEEL_MASK], expired);
+
+        wheel_time_ += width;
+        ++wheel_now_;
+
+        /* Cascade the upper levels whose slot boundary was crossed */
+        for( uint8_t level = 1; level < SCHEDULER_WHEEL_LEVELS; ++level )
+        {
+            if( (wheel_now_ & ((1u << (level * SCHEDULER_WHEEL_SLOT_BITS)) - 1)) != 0 )
+                break;
+
+            const uint32_t index = wheel_now_ >> (level * SCHEDULER_WHEEL_SLOT_BITS);
+            wheelCascade(&wheel_slots_[level * WHEEL_SLOTS + (index & WHEEL_MASK)]);
+        }
+    }
+
+    /* The current slot may also hold tasks that are due later within the slot */
+    wheelCollect(&wheel_slots_[wheel_now_ & WHEEL_MASK], expired);
+
+    while( expired != WHEEL_END )
+    {
+        const uint16_t task = expired;
+        Task& t = task_table_[task];
+        expired = wheel_links_[task];
+
+        /* Drop tasks whose function was cleared, or that were stopped */
+        if( !t.isRunnable() )
+        {
+            dropTask(task);
+            continue;
+        }
+
+        /* obtain a copy of the sys_tick_ctr at the execution to avoid concurrency */
+        sysctr = getTickCount();
+
+        if( sysctr - t.last_called_ >= t.interval )
+        {
+            /* Run the task that is already due */
+            dispatch(t, sysctr);
+        }
+
+        /* Hand a timer that ran, or a task removed by its function, back to the pool */
+        if( (t.state_ & Task::STATE_FREE) != 0 )
+        {
+            dropTask(task);
             continue;
         }
 
+        wheelInsert(task);
     }
 }
+#endif
@@ -41,8 +41,318 @@
     #define NULL (0)
 #endif
 
+/*  Define SCHEDULER_64BIT_TICK to use a 64-bit system tick, so that tasks can have
+*   hours-long intervals at microsecond resolution without the counter wrapping.
+*   Reads of the counter stay consistent on 32-bit CPUs, see Scheduler::getTickCount().
+*/
+
+/*  Define SCHEDULER_ENABLE_STATS to keep per-task execution time and release
+*   jitter statistics. When undefined, the statistics cost no memory and no cycles.
+*/
+
+/*  Define SCHEDULER_ENABLE_LOAD to measure the CPU load over the last 1, 10 and 60
+*   seconds, and the share of each task, see Scheduler::getCpuLoad().
+*/
+
+/* System tick count of one second, used by the CPU load windows */
+#ifndef SCHEDULER_LOAD_TICKS_PER_SECOND
+    #define SCHEDULER_LOAD_TICKS_PER_SECOND     (1000000)
+#endif
+
+/* Number of one second windows kept by the CPU load monitor */
+#define SCHEDULER_LOAD_HISTORY      (60)
+
+/*  Define SCHEDULER_ENABLE_TRACE to record task starts and ends, ticks and timing
+*   faults into a ring buffer, see Scheduler::useTraceBuffer().
+*/
+
+/*  Define SCHEDULER_ENABLE_HEAP to build in DISPATCH_HEAP, see Scheduler::useHeapDispatch().
+*   Only the linear scan is always built in, the dispatch modes left undefined cost
+*   no code and no memory.
+*/
+
+/* Define SCHEDULER_ENABLE_WHEEL to build in DISPATCH_WHEEL, see Scheduler::useWheelDispatch() */
+
+/*  Define SCHEDULER_ENABLE_PRIORITY to build in DISPATCH_PRIORITY and Task::priority,
+*   see Scheduler::usePriorityDispatch().
+*/
+
+/*  Define SCHEDULER_ENABLE_EDF to build in DISPATCH_EDF and Task::deadline, see
+*   Scheduler::useEdfDispatch(). Without it, the deadline of a task is its interval.
+*/
+
+/* Define SCHEDULER_ENABLE_BITMAP to build in DISPATCH_BITMAP, see Scheduler::useBitmapDispatch() */
+
+/*  Define SCHEDULER_ENABLE_BUDGET to report the runs that exceed Task::budget,
+*   see Scheduler::setTimingFaultHandler().
+*/
+
+/*  Define SCHEDULER_ENABLE_PHASE to delay the first release of each task by Task::phase,
+*   see Scheduler::assignPhaseOffsets().
+*/
+
+/*  Define SCHEDULER_ENABLE_RELEASE_ARRAY to build in DISPATCH_RELEASE_ARRAY,
+*   see Scheduler::useReleaseArrayDispatch().
+*/
+
+/* The cycle counter is kept when any feature measures time with it */
+#if defined(SCHEDULER_ENABLE_STATS) || defined(SCHEDULER_ENABLE_LOAD) || defined(SCHEDULER_ENABLE_TRACE)
+    #define SCHEDULER_HAS_CYCLE_COUNTER
+#endif
+
+/* The dispatch storage is kept when any mode needs some */
+#if defined(SCHEDULER_ENABLE_HEAP) || defined(SCHEDULER_ENABLE_WHEEL) || defined(SCHEDULER_ENABLE_PRIORITY) || \
+    defined(SCHEDULER_ENABLE_BITMAP) || defined(SCHEDULER_ENABLE_RELEASE_ARRAY)
+    #define SCHEDULER_HAS_DISPATCH_STORAGE
+#endif
+
+/* Number of levels of the timing wheel used by DISPATCH_WHEEL */
+#ifndef SCHEDULER_WHEEL_LEVELS
+    #define SCHEDULER_WHEEL_LEVELS      (4)
+#endif
+
+/* Number of slots per timing wheel level, as a power of two */
+#ifndef SCHEDULER_WHEEL_SLOT_BITS
+    #define SCHEDULER_WHEEL_SLOT_BITS   (6)
+#endif
+
+/* Index of the lowest set bit of a non-zero 32-bit word, used by DISPATCH_BITMAP */
+#ifndef SCHEDULER_CTZ
+    #if defined(__GNUC__) || defined(__clang__)
+        #define SCHEDULER_CTZ(x)    ((uint8_t)__builtin_ctz(x))
+    #endif
+#endif
+
+/* Keeps the compiler from moving memory accesses across it, used between run() and tick() */
+#ifndef SCHEDULER_COMPILER_BARRIER
+    #if defined(__GNUC__) || defined(__clang__)
+        #define SCHEDULER_COMPILER_BARRIER()    __asm__ __volatile__("" ::: "memory")
+    #else
+        #define SCHEDULER_COMPILER_BARRIER()
+    #endif
+#endif
+
 class Scheduler {
 public:
+    /**
+     * @brief Type of the system tick and of task intervals.
+     *
+     */
+#ifdef SCHEDULER_64BIT_TICK
+    typedef uint64_t tick_t;
+#else
+    typedef uint32_t tick_t;
+#endif
+
+#ifdef SCHEDULER_ENABLE_STATS
+    /**
+     * @brief Execution statistics of a single task.
+     * Runtimes are in cycles of the counter given to setCycleCounter(),
+     * release jitter is in system ticks.
+     *
+     */
+    struct TaskStats {
+        uint32_t run_count;         /*!< Number of times the task was run */
+        uint32_t overrun_count;     /*!< Runs that took at least a whole interval */
+        uint32_t deadline_miss_count;   /*!< Runs that completed after their deadline */
+        uint32_t min_runtime;       /*!< Shortest run */
+        uint32_t max_runtime;       /*!< Longest run */
+        uint64_t total_runtime;     /*!< Sum of all runs, see getAverageRuntime() */
+        tick_t max_jitter;          /*!< Largest delay between release and start */
+
+        /**
+         * @brief Get the average runtime
+         *
+         * @return uint32_t Average runtime in cycles, 0 before the first run
+         */
+        uint32_t getAverageRuntime(void) const {
+            return (run_count == 0) ? 0 : (uint32_t)(total_runtime / run_count);
+        }
+
+        /**
+         * @brief Clear the statistics
+         *
+         */
+        void reset(void) {
+            run_count = 0;
+            overrun_count = 0;
+            deadline_miss_count = 0;
+            min_runtime = UINT32_MAX;
+            max_runtime = 0;
+            total_runtime = 0;
+            max_jitter = 0;
+        }
+    };
+#endif
+
+    /**
+     * @brief Selects how run() finds the tasks that are due.
+     * The modes other than DISPATCH_LINEAR are selectable when built in, see SCHEDULER_ENABLE_HEAP.
+     *
+     */
+    enum DispatchMode {
+        DISPATCH_LINEAR = 0,    /*!< Scan the whole task table on every run() (default) */
+        DISPATCH_HEAP,          /*!< Keep periodic tasks in a min-heap keyed on their next release */
+        DISPATCH_WHEEL,         /*!< Keep tasks in a hierarchical timing wheel */
+        DISPATCH_PRIORITY,      /*!< Scan the task table in priority order */
+        DISPATCH_EDF,           /*!< Run the due task with the earliest absolute deadline first */
+        DISPATCH_BITMAP,        /*!< tick() marks due tasks in a ready bitmap that run() walks */
+        DISPATCH_RELEASE_ARRAY  /*!< Check a contiguous array of next releases, apart from the tasks */
+    };
+
+    /**
+     * @brief Selects how the next release of a periodic task is computed after it runs.
+     *
+     */
+    enum ReleasePolicy {
+        RELEASE_FREE_RUNNING = 0,   /*!< Next release is one interval after the task ran, lateness accumulates (default) */
+        RELEASE_SKIP_MISSED,        /*!< Phase-locked. A task late by a whole interval or more does not run
+                                         and waits for its next release */
+        RELEASE_RUN_ONCE,           /*!< Phase-locked. Missed releases are merged into a single run */
+        RELEASE_RUN_ALL_MISSED      /*!< Phase-locked. Every missed release is run, back to back */
+    };
+
+#ifdef SCHEDULER_ENABLE_LOAD
+    /**
+     * @brief Windows over which getCpuLoad() averages
+     *
+     */
+    enum LoadWindow {
+        LOAD_1S = 0,    /*!< Last second */
+        LOAD_10S,       /*!< Last 10 seconds */
+        LOAD_60S        /*!< Last 60 seconds */
+    };
+#endif
+
+    /**
+     * @brief Timing faults reported to the handler set with setTimingFaultHandler().
+     *
+     */
+    enum TimingFault {
+        FAULT_DEADLINE_MISS = 0,    /*!< A periodic task completed after its deadline, or its release was skipped */
+        FAULT_BUDGET_OVERRUN        /*!< A task ran for longer than its budget */
+    };
+
+#if defined(SCHEDULER_ENABLE_HEAP) || defined(SCHEDULER_ENABLE_BITMAP)
+    /**
+     * @brief A single entry of the dispatch queue used by DISPATCH_HEAP.
+     * Storage for these is provided by the application, see useHeapDispatch().
+     *
+     */
+    struct DispatchEntry {
+        tick_t release;         /*!< Tick at which the task is next due */
+        uint16_t task;          /*!< Index of the task in the task table */
+    };
+#endif
+
+    static const uint16_t POOL_END = 0xFFFF;                                    /*!< End of the list of free task slots */
+
+#ifdef SCHEDULER_ENABLE_WHEEL
+    static const uint16_t WHEEL_SLOTS = (1u << SCHEDULER_WHEEL_SLOT_BITS);    /*!< Slots per wheel level */
+    static const uint16_t WHEEL_END = 0xFFFF;                                   /*!< End of a wheel slot list */
+
+    /**
+     * @brief Storage of the timing wheel used by DISPATCH_WHEEL, sized at compile time.
+     * Declare one statically and pass it to useWheelDispatch().
+     *
+     * @tparam NUM_TASKS Maximum number of tasks in the bound task table
+     */
+    template <uint16_t NUM_TASKS>
+    struct TimingWheel {
+        uint16_t slots[SCHEDULER_WHEEL_LEVELS * WHEEL_SLOTS];  /*!< Head of the task list of each slot */
+        uint16_t links[NUM_TASKS];                              /*!< Next task in the same slot */
+    };
+#endif
+
+#ifdef SCHEDULER_ENABLE_BITMAP
+    /**
+     * @brief Storage of the ready bitmap used by DISPATCH_BITMAP, sized at compile time.
+     * Declare one statically and pass it to useBitmapDispatch().
+     *
+     * @tparam NUM_TASKS Maximum number of tasks in the bound task table
+     */
+    template <uint16_t NUM_TASKS>
+    struct ReadyBitmap {
+        uint32_t released[(NUM_TASKS + 31) / 32];      /*!< Toggled by tick() when a task becomes due */
+        uint32_t acknowledged[(NUM_TASKS + 31) / 32];  /*!< Toggled by run() when a task has run */
+        uint32_t scanned[(NUM_TASKS + 31) / 32];       /*!< Acknowledgements seen by tick() */
+        DispatchEntry pending[NUM_TASKS];               /*!< Heap of the releases of the tasks that are not ready */
+    };
+#endif
+
+#ifdef SCHEDULER_ENABLE_RELEASE_ARRAY
+    /**
+     * @brief Storage of the release array used by DISPATCH_RELEASE_ARRAY, sized at compile time.
+     * Declare one statically and pass it to useReleaseArrayDispatch().
+     *
+     * @tparam NUM_TASKS Maximum number of tasks in the bound task table
+     */
+    template <uint16_t NUM_TASKS>
+    struct ReleaseArray {
+        tick_t releases[NUM_TASKS];     /*!< Next release of each task, indexed like the task table */
+    };
+#endif
+
+#ifdef SCHEDULER_ENABLE_TRACE
+    /**
+     * @brief Kinds of trace events
+     *
+     */
+    enum TraceEventType {
+        TRACE_TASK_START = 0,   /*!< A task is about to run */
+        TRACE_TASK_END,         /*!< A task returned */
+        TRACE_TICK,             /*!< tick() was called */
+        TRACE_DEADLINE_MISS,    /*!< A task missed its deadline */
+        TRACE_BUDGET_OVERRUN    /*!< A task overran its budget */
+    };
+
+    /**
+     * @brief Array a traced task belongs to
+     *
+     */
+    enum TraceSource {
+        TRACE_TASK_TABLE = 0,   /*!< The task table given to init() */
+        TRACE_EVENT_TASKS,      /*!< The event tasks given to useEventQueue() */
+        TRACE_BACKGROUND_TASKS  /*!< The background tasks given to useBackgroundTasks() */
+    };
+
+    /**
+     * @brief A single trace record, 8 bytes
+     *
+     */
+    struct TraceEvent {
+        uint32_t timestamp;     /*!< Cycle counter, or the system tick when none is set */
+        uint16_t task;          /*!< Index of the task in its array, 0 for TRACE_TICK */
+        uint8_t type;           /*!< TraceEventType */
+        uint8_t source;         /*!< TraceSource */
+    };
+    static_assert(sizeof(TraceEvent) == 8, "TraceEvent must stay 8 bytes");
+
+    /**
+     * @brief Storage of the trace ring buffer, sized at compile time.
+     * Declare one statically and pass it to useTraceBuffer().
+     *
+     * @tparam CAPACITY Number of events kept, a power of two
+     */
+    template <uint32_t CAPACITY>
+    struct TraceBuffer {
+        static_assert(CAPACITY != 0 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+        TraceEvent events[CAPACITY];    /*!< Most recent events, oldest overwritten first */
+    };
+#endif
+
+    /**
+     * @brief Storage of the event queue filled by post(), sized at compile time.
+     * Declare one statically and pass it to useEventQueue().
+     *
+     * @tparam CAPACITY Maximum number of pending events, a power of two
+     */
+    template <uint16_t CAPACITY>
+    struct EventQueue {
+        static_assert(CAPACITY != 0 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+        uint16_t events[CAPACITY];      /*!< Indices of the posted event tasks */
+    };
+
     /**
      * @brief A single task to be ran by the scheduler.
      *
@@ -51,6 +361,16 @@ public:
         public:
             friend class Scheduler;
 
+            /**
+             * @brief Construct an unused slot of a task pool, filled by Scheduler::addTask().
+             *
+             */
+            Task(void) : func(NULL), interval(0), state_(STATE_FREE) {
+#ifdef SCHEDULER_ENABLE_STATS
+                stats.reset();
+#endif
+            }
+
             /**
              * @brief Construct a new Task to be ran by the scheduler. This task
              * should be initialized as part of an array.
@@ -58,21 +378,136 @@ public:
              * @param func Function point to be ran by the scheduler.
              * @param interval Interval (typically in microseconds) that the scheduler runs the function.
              */
-            Task(void (*func)(), volatile uint32_t interval) : func(func), interval(interval) {}
+            Task(void (*func)(), volatile tick_t interval) : func(func), interval(interval) {
+#ifdef SCHEDULER_ENABLE_STATS
+                stats.reset();
+#endif
+            }
+
+            /**
+             * @brief Construct a new Task whose function receives a context pointer,
+             * so that one function can serve several instances without a trampoline.
+             *
+             * @param context_func Function point to be ran by the scheduler with [context].
+             * @param context Pointer passed to [context_func] on every run, may be NULL.
+             * @param interval Interval (typically in microseconds) that the scheduler runs the function.
+             */
+            Task(void (*context_func)(void*), void* context, volatile tick_t interval) :
+                func(NULL), interval(interval), context_func(context_func), context(context) {
+#ifdef SCHEDULER_ENABLE_STATS
+                stats.reset();
+#endif
+            }
+
+            /**
+             * @brief Construct a new Task that calls a member function of [object].
+             * No memory is allocated, the binding is a function generated per member.
+             *
+             * @code
+             * Scheduler::Task::bind<Uart, &Uart::poll>(&uart0, 1000)
+             * @endcode
+             *
+             * @tparam T Class of [object]
+             * @tparam METHOD Member function to be ran by the scheduler
+             * @param object Instance that [METHOD] is called on
+             * @param interval Interval (typically in microseconds) that the scheduler runs the function.
+             * @return Task Task bound to [object]
+             */
+            template <class T, void (T::*METHOD)()>
+            static Task bind(T* const object, const tick_t interval) {
+                return Task(&callMember<T, METHOD>, object, interval);
+            }
 
             void (*func)();
-            volatile uint32_t interval;
+            volatile tick_t interval;
+            void (*context_func)(void*) = NULL;     /*!< Used instead of [func] when [func] is NULL */
+            void* context = NULL;                   /*!< Passed to [context_func] */
+#ifdef SCHEDULER_ENABLE_PRIORITY
+            uint8_t priority = 0;                   /*!< Used by DISPATCH_PRIORITY, higher values run first */
+#endif
+#ifdef SCHEDULER_ENABLE_EDF
+            tick_t deadline = 0;                    /*!< Deadline relative to each release, 0 for the interval */
+#endif
+#ifdef SCHEDULER_ENABLE_BUDGET
+            tick_t budget = 0;                      /*!< Longest allowed run in system ticks, 0 for no limit */
+#endif
+#ifdef SCHEDULER_ENABLE_PHASE
+            tick_t phase = 0;                       /*!< First release after init() or addTask(), less than the interval */
+#endif
+
+#ifdef SCHEDULER_ENABLE_STATS
+            TaskStats stats;            /*!< Execution statistics, updated by run() */
+#endif
+#ifdef SCHEDULER_ENABLE_LOAD
+            uint16_t load = 0;          /*!< Share of the CPU in the last second, in per mille */
+#endif
+
+            /**
+             * @brief Whether the task is in use, enabled and not suspended
+             *
+             * @return true When the scheduler may run it
+             */
+            bool isActive(void) const {
+                return (state_ & (STATE_FREE | STATE_DISABLED | STATE_SUSPENDED)) == 0;
+            }
 
         private:
-            uint32_t last_called_ = 0;
+            enum {
+                STATE_FREE = 0x01,      /*!< Unused pool slot */
+                STATE_DISABLED = 0x02,  /*!< Stopped by disableTask() */
+                STATE_SUSPENDED = 0x04, /*!< Stopped by suspendTask() */
+                STATE_QUEUED = 0x08,    /*!< Has an entry in the heap or the timing wheel */
+                STATE_ONESHOT = 0x10,   /*!< Software timer, freed once it ran */
+                STATE_PICKED = 0x20     /*!< Already ran in the current call of runEdf() */
+            };
+
+            /* Next free slot while STATE_FREE and not queued */
+            tick_t last_called_ = 0;
+            uint8_t state_ = 0;
+#ifdef SCHEDULER_ENABLE_LOAD
+            uint32_t load_cycles_ = 0;  /*!< Time spent in the task in the current second */
+#endif
+
+            /* Whether the task has a function to run */
+            bool hasFunction(void) const {
+                return func != NULL || context_func != NULL;
+            }
+
+            /* Whether the task has a function and is active */
+            bool isRunnable(void) const {
+                return isActive() && hasFunction();
+            }
+
+            /* Deadline relative to each release */
+            tick_t relativeDeadline(void) const {
+#ifdef SCHEDULER_ENABLE_EDF
+                return (deadline != 0) ? deadline : (tick_t)interval;
+#else
+                return interval;
+#endif
+            }
+
+            /* Runs the task function */
+            void call(void) {
+                if( func != NULL )
+                    (*func)();
+                else
+                    (*context_func)(context);
+            }
+
+            template <class T, void (T::*METHOD)()>
+            static void callMember(void* object) {
+                (static_cast<T*>(object)->*METHOD)();
+            }
     };
 
     /**
      * @brief System tick count, typically represented in microseconds.
      * Public access is given to allow for control within ISR without a function call.
      * Do not decrement this value.
+     * With SCHEDULER_64BIT_TICK, only update it through tick() so that reads stay consistent.
      */
-    volatile uint32_t sys_tick_ctr_ = 0;    /*!< System tick counter */
+    volatile tick_t sys_tick_ctr_ = 0;      /*!< System tick counter */
 
 
     /**
@@ -86,7 +521,8 @@ public:
      * @param num_tasks Number of members in array [taskTable]
      * @param systick_interval  Actual duration of a single systick, typically in microseconds
      * @return true     On successful initialization
-     * @return false    Returns false when one of the functions in the [taskTable] is null.
+     * @return false    Returns false when [systick_interval] is 0, or when one of the tasks
+     *                  in the [taskTable] has no function, or a phase that is not less than its interval.
      */
     bool init(Task* const taskTable, const uint16_t num_tasks, const uint32_t systick_interval);
 
@@ -99,7 +535,8 @@ public:
      *                  that will be used by the scheduler.
      * @param systick_interval  Actual duration of a single systick, typically in microseconds
      * @return true     On successful initialization
-     * @return false    Returns false when one of the functions in the [taskTable] is null.
+     * @return false    Returns false when one of the tasks in the [taskTable] has no function,
+     *                  or a phase that is not less than its interval.
      */
     bool init(Task* const taskTable, const uint16_t num_tasks);
 
@@ -112,27 +549,742 @@ public:
     /**
      * @brief Increments the system tick by the systick_interval.
      *
-     * @return uint32_t Current tick
+     * @return tick_t Current tick
      */
-    uint32_t tick(void);
+    tick_t tick(void);
 
     /**
-     * @brief Get the system tick counter value
+     * @brief   Get the system tick counter value.
+     *          With SCHEDULER_64BIT_TICK the counter is re-read until no tick() happened
+     *          in between, so that a 32-bit CPU never sees a torn value.
+     *          Do not call it from an interrupt that can preempt tick().
      *
-     * @return uint32_t System Tick Counter Value
+     * @return tick_t System Tick Counter Value
      */
-    uint32_t getTickCount(void);
+    tick_t getTickCount(void) {
+#ifdef SCHEDULER_64BIT_TICK
+        uint32_t seq;
+        tick_t value;
+        do {
+            seq = tick_seq_;
+            value = sys_tick_ctr_;
+        } while( seq != tick_seq_ );
+        return value;
+#else
+        return sys_tick_ctr_;
+#endif
+    }
 
     /**
      * @brief Set the system tick interval
      *
      * @param systick_interval Duration of a single systick, typically in microseconds
+     * @return true     On success
+     * @return false    When [systick_interval] is 0, the interval is left unchanged
+     */
+    bool setTickInterval(const uint32_t systick_interval);
+
+#ifdef SCHEDULER_HAS_CYCLE_COUNTER
+    /**
+     * @brief   Set the cycle counter used to measure task runtimes, typically
+     *          a free-running hardware counter such as DWT->CYCCNT.
+     *          Runtimes are not measured while no counter is set, and the CPU load
+     *          falls back to the system tick.
+     *
+     * @param cycle_counter Function returning the current cycle count
+     */
+    void setCycleCounter(uint32_t (*cycle_counter)(void));
+#endif
+
+#ifdef SCHEDULER_ENABLE_LOAD
+    /**
+     * @brief   Get the fraction of time spent in event and time-triggered tasks,
+     *          averaged over the last completed one second windows. Idle passes of
+     *          run(), including background tasks, count as idle.
+     *          The per-task share of the last second is in Task::load.
+     *
+     * @param window Number of seconds to average over
+     * @return uint16_t CPU load in per mille, 0 before the first second completed
+     */
+    uint16_t getCpuLoad(const LoadWindow window);
+#endif
+
+#ifdef SCHEDULER_ENABLE_TRACE
+    /**
+     * @brief   Start recording trace events into [buffer], dropping the previous trace.
+     *          Once full, the oldest events are overwritten.
+     *
+     * @tparam CAPACITY Capacity of [buffer]
+     * @param buffer Trace storage, owned by the application
+     */
+    template <uint32_t CAPACITY>
+    void useTraceBuffer(TraceBuffer<CAPACITY>& buffer) {
+        useTraceBuffer(buffer.events, CAPACITY);
+    }
+
+    /**
+     * @brief   Start recording trace events into raw storage.
+     *          Prefer the TraceBuffer overload, which checks the capacity at compile time.
+     *
+     * @param storage   Array of [capacity] events, NULL to stop tracing
+     * @param capacity  Number of events in [storage], a power of two
+     * @return true     On success
+     * @return false    When [capacity] is not a power of two
+     */
+    bool useTraceBuffer(TraceEvent* const storage, const uint32_t capacity);
+
+    /**
+     * @brief   Get the number of events recorded since useTraceBuffer(). Event [i]
+     *          is at index (i & (capacity - 1)) of the storage, and only the last
+     *          [capacity] events are kept.
+     *
+     * @return uint32_t Number of recorded events
+     */
+    uint32_t getTraceCount(void);
+
+    /**
+     * @brief   Copy the recorded events, oldest first, e.g. to dump them after a fault.
+     *          Events recorded during the copy may be torn.
+     *
+     * @param out       Array of [max_events] events
+     * @param max_events Number of events that fit in [out]
+     * @return uint32_t Number of events copied, the most recent ones
+     */
+    uint32_t copyTrace(TraceEvent* const out, const uint32_t max_events);
+#endif
+
+#ifdef SCHEDULER_ENABLE_STATS
+    /**
+     * @brief Clear the statistics of all bound tasks
+     *
+     */
+    void resetStats(void);
+#endif
+
+    /**
+     * @brief   Set how the next release of periodic tasks is computed.
+     *          The phase-locked policies release a task on (last release + interval),
+     *          so a busy loop delays single runs without drifting the task.
+     *
+     * @param policy Release policy used by all periodic tasks
+     */
+    void setReleasePolicy(const ReleasePolicy policy);
+
+    /**
+     * @brief Get the active release policy
+     *
+     * @return ReleasePolicy Active release policy
+     */
+    ReleasePolicy getReleasePolicy(void);
+
+    /**
+     * @brief   Set the function called from run() when a task misses its deadline or
+     *          overruns its budget. It is called after the task's next release is
+     *          computed, so it may log, change the task (e.g. its interval) to shed load,
+     *          or reset the system.
+     *
+     * @param handler Function called with the faulty task and the fault, NULL for none
+     */
+    void setTimingFaultHandler(void (*handler)(Task& task, TimingFault fault));
+
+    /**
+     * @brief Get the number of deadline misses of all tasks since init()
+     *
+     * @return uint32_t Number of deadline misses
      */
-    void setTickInterval(const uint32_t systick_interval);
+    uint32_t getDeadlineMissCount(void);
+
+#ifdef SCHEDULER_ENABLE_BUDGET
+    /**
+     * @brief Get the number of budget overruns of all tasks since init()
+     *
+     * @return uint32_t Number of budget overruns
+     */
+    uint32_t getBudgetOverrunCount(void);
+#endif
+
+    /**
+     * @brief   Get the earliest release among the bound tasks, for tickless operation.
+     *          The application can program a one-shot timer for this tick and sleep
+     *          instead of calling tick() on every systick.
+     *
+     * @param deadline  Receives the tick of the earliest release, or the current tick
+     *                  when a task is already due
+     * @return true     When a task is pending
+     * @return false    When no task is bound. [deadline] is left untouched.
+     */
+    bool getNextDeadline(tick_t& deadline);
+
+    /**
+     * @brief   Get the number of systicks until the earliest release, rounded up.
+     *
+     * @return uint32_t Systicks to sleep, 0 when a task is already due,
+     *                  or UINT32_MAX when no task is bound. Longer waits are capped below UINT32_MAX.
+     */
+    uint32_t getTicksToNextDeadline(void);
+
+    /**
+     * @brief   Catch up the system tick after sleeping, as if tick() was called [num_ticks] times.
+     *          Call this while the tick interrupt is stopped.
+     *
+     * @param num_ticks Number of systicks that elapsed
+     * @return tick_t Current tick
+     */
+    tick_t advanceTicks(const uint32_t num_ticks);
+
+    /**
+     * @brief   Dispatch using a linear scan of the task table (default).
+     *          Cheapest for small tables.
+     *
+     */
+    void useLinearDispatch(void);
+
+#ifdef SCHEDULER_ENABLE_HEAP
+    /**
+     * @brief   Dispatch using a min-heap ordered by next release, so that run()
+     *          only touches the tasks that are actually due.
+     *          May be called before or after init(). The queue is rebuilt on every init().
+     *
+     * @note    Continuous tasks (interval of 0) are kept at the front of [storage]
+     *          and are run on every pass. Whether a task is continuous is sampled
+     *          when the queue is built, and a changed interval only takes effect
+     *          on the task's next release.
+     *          Intervals must be below half the range of tick_t.
+     *
+     * @param storage   Array of [capacity] entries, owned by the application
+     * @param capacity  Number of entries in [storage], at least the number of tasks
+     * @return true     On success
+     * @return false    When [storage] is NULL or too small for the bound task table.
+     *                  The dispatch mode is left unchanged.
+     */
+    bool useHeapDispatch(DispatchEntry* const storage, const uint16_t capacity);
+#endif
+
+#ifdef SCHEDULER_ENABLE_WHEEL
+    /**
+     * @brief   Dispatch using a hierarchical timing wheel, so that tick() and run()
+     *          cost O(1) amortized regardless of the number of tasks.
+     *          May be called before or after init(). The wheel is rebuilt on every init().
+     *
+     * @note    The slot width is the largest power of two not above the systick interval
+     *          given to init(). Tasks never run early, and a changed interval only
+     *          takes effect on the task's next release.
+     *          Intervals should be below half the range of tick_t, longer ones are
+     *          checked on every run(). After a long gap, e.g. advanceTicks(), run() moves
+     *          to the current slot at once instead of walking the elapsed ones.
+     *
+     * @tparam NUM_TASKS Capacity of [wheel]
+     * @param wheel     Wheel storage, owned by the application
+     * @return true     On success
+     * @return false    When [wheel] is too small for the bound task table.
+     *                  The dispatch mode is left unchanged.
+     */
+    template <uint16_t NUM_TASKS>
+    bool useWheelDispatch(TimingWheel<NUM_TASKS>& wheel) {
+        return useWheelDispatch(wheel.slots, wheel.links, NUM_TASKS);
+    }
+
+    /**
+     * @brief   Dispatch using a hierarchical timing wheel over raw storage.
+     *          Prefer the TimingWheel overload, which sizes the storage at compile time.
+     *
+     * @param slots     Array of (SCHEDULER_WHEEL_LEVELS * WHEEL_SLOTS) slot heads
+     * @param links     Array of [capacity] slot links
+     * @param capacity  Number of entries in [links], at least the number of tasks
+     * @return true     On success
+     * @return false    When the storage is NULL or too small for the bound task table.
+     */
+    bool useWheelDispatch(uint16_t* const slots, uint16_t* const links, const uint16_t capacity);
+#endif
+
+#ifdef SCHEDULER_ENABLE_PRIORITY
+    /**
+     * @brief   Dispatch using a scan of the task table in priority order, so that when
+     *          several tasks are due in one run(), the higher priorities run first.
+     *          Tasks of equal priority run in table order.
+     *          May be called before or after init(). The order is rebuilt on every init().
+     *
+     * @note    Priorities are sampled when the order is built. Call this again
+     *          after changing them.
+     *
+     * @param order     Array of [capacity] task indices, owned by the application
+     * @param capacity  Number of entries in [order], at least the number of tasks
+     * @return true     On success
+     * @return false    When [order] is NULL or too small for the bound task table.
+     *                  The dispatch mode is left unchanged.
+     */
+    bool usePriorityDispatch(uint16_t* const order, const uint16_t capacity);
+#endif
+
+#ifdef SCHEDULER_ENABLE_EDF
+    /**
+     * @brief   Dispatch using earliest-deadline-first. Every time a task completes,
+     *          run() picks among the due tasks the one whose absolute deadline
+     *          (release + Task::deadline) is the nearest. Needs no extra storage.
+     *          Continuous tasks run once per run(), after the periodic ones.
+     *
+     * @note    Each pick scans the task table, which suits tables of a few dozen tasks.
+     *
+     */
+    void useEdfDispatch(void);
+#endif
+
+#ifdef SCHEDULER_ENABLE_BITMAP
+    /**
+     * @brief   Dispatch using a ready bitmap. tick() marks the tasks that became due,
+     *          and run() only visits the marked tasks, found with count-trailing-zeros,
+     *          so that run() is nearly free when nothing is ready.
+     *          May be called before or after init(). The bitmap is rebuilt on every init().
+     *
+     * @note    tick() scans the task table only on ticks where the earliest release was
+     *          reached, or where a task completed since the previous tick.
+     *          Whether a task is continuous is sampled when the bitmap is built.
+     *
+     * @tparam NUM_TASKS Capacity of [bitmap]
+     * @param bitmap    Bitmap storage, owned by the application
+     * @return true     On success
+     * @return false    When [bitmap] is too small for the bound task table.
+     *                  The dispatch mode is left unchanged.
+     */
+    template <uint16_t NUM_TASKS>
+    bool useBitmapDispatch(ReadyBitmap<NUM_TASKS>& bitmap) {
+        return useBitmapDispatch(bitmap.released, bitmap.acknowledged, bitmap.scanned, (NUM_TASKS + 31) / 32,
+                                 bitmap.pending, NUM_TASKS);
+    }
+
+    /**
+     * @brief   Dispatch using a ready bitmap over raw storage.
+     *          Prefer the ReadyBitmap overload, which sizes the storage at compile time.
+     *
+     * @param released      Array of [num_words] words toggled by tick()
+     * @param acknowledged  Array of [num_words] words toggled by run()
+     * @param scanned       Array of [num_words] words written by tick()
+     * @param num_words     Number of words in each array, at least one per 32 tasks
+     * @param pending       Array of [capacity] entries, ordered on release by tick()
+     * @param capacity      Number of entries in [pending], at least the number of tasks
+     * @return true     On success
+     * @return false    When the storage is NULL or too small for the bound task table.
+     */
+    bool useBitmapDispatch(uint32_t* const released, uint32_t* const acknowledged, uint32_t* const scanned,
+                           const uint16_t num_words, DispatchEntry* const pending, const uint16_t capacity);
+#endif
+
+#ifdef SCHEDULER_ENABLE_RELEASE_ARRAY
+    /**
+     * @brief   Dispatch using an array of next releases kept apart from the task table.
+     *          run() checks 32 tasks at a time over the contiguous releases, without
+     *          branches, so the check can be vectorized and does not load the function
+     *          pointers, then only visits the due tasks, found with count-trailing-zeros.
+     *          May be called before or after init(). The array is rebuilt on every init().
+     *
+     * @note    A task that becomes due after its block of 32 was checked runs on the next pass.
+     *          A shorter interval set at runtime takes effect after the next release.
+     *
+     * @tparam NUM_TASKS Capacity of [releases]
+     * @param releases  Release array storage, owned by the application
+     * @return true     On success
+     * @return false    When [releases] is too small for the bound task table.
+     *                  The dispatch mode is left unchanged.
+     */
+    template <uint16_t NUM_TASKS>
+    bool useReleaseArrayDispatch(ReleaseArray<NUM_TASKS>& releases) {
+        return useReleaseArrayDispatch(releases.releases, NUM_TASKS);
+    }
+
+    /**
+     * @brief   Dispatch using an array of next releases over raw storage.
+     *          Prefer the ReleaseArray overload, which sizes the storage at compile time.
+     *
+     * @param releases  Array of [capacity] ticks
+     * @param capacity  Number of members in array [releases]
+     * @return true     On success
+     * @return false    When the storage is NULL or too small for the bound task table.
+     */
+    bool useReleaseArrayDispatch(tick_t* const releases, const uint16_t capacity);
+#endif
+
+    /**
+     * @brief   Enable event-triggered tasks. Each post() of an index into [eventTasks]
+     *          releases that task once; run() runs the pending events in posting order
+     *          before any time-triggered task. The interval, deadline and priority of
+     *          event tasks are ignored.
+     *          Call this before the interrupts that post events are enabled.
+     *
+     * @tparam CAPACITY Capacity of [queue]
+     * @param eventTasks        Array of event tasks, separate from the task table
+     * @param num_event_tasks   Number of members in array [eventTasks]
+     * @param queue             Queue storage, owned by the application
+     * @return true     On success
+     * @return false    When a task has no function
+     */
+    template <uint16_t CAPACITY>
+    bool useEventQueue(Task* const eventTasks, const uint16_t num_event_tasks, EventQueue<CAPACITY>& queue) {
+        return useEventQueue(eventTasks, num_event_tasks, queue.events, CAPACITY);
+    }
+
+    /**
+     * @brief   Enable event-triggered tasks over raw queue storage.
+     *          Prefer the EventQueue overload, which checks the capacity at compile time.
+     *
+     * @param eventTasks        Array of event tasks, separate from the task table
+     * @param num_event_tasks   Number of members in array [eventTasks]
+     * @param storage           Array of [capacity] entries
+     * @param capacity          Number of entries in [storage], a power of two
+     * @return true     On success
+     * @return false    When [eventTasks] or [storage] is NULL, a task has no function,
+     *                  or [capacity] is not a power of two.
+     */
+    bool useEventQueue(Task* const eventTasks, const uint16_t num_event_tasks, uint16_t* const storage, const uint16_t capacity);
+
+    /**
+     * @brief   Release the event task [event_task] once. Lock-free, to be called from
+     *          a single producer context, e.g. interrupts of one priority level.
+     *
+     * @param event_task Index into the event task array
+     * @return true     When the event was queued
+     * @return false    When the queue is full or [event_task] is out of range
+     */
+    bool post(const uint16_t event_task);
+
+    /**
+     * @brief   Set the background tasks. They run only on passes of run() where no event
+     *          or time-triggered task ran, replacing continuous tasks (interval of 0) in
+     *          the task table, which run on every pass and keep the CPU busy.
+     *          Their interval, deadline and priority are ignored.
+     *
+     * @param backgroundTasks       Array of background tasks, separate from the task table
+     * @param num_background_tasks  Number of members in array [backgroundTasks], 0 for none
+     * @return true     On success
+     * @return false    When a task has no function
+     */
+    bool useBackgroundTasks(Task* const backgroundTasks, const uint16_t num_background_tasks);
+
+    /**
+     * @brief   Set the function called by run() on passes where no event or
+     *          time-triggered task ran, after the background tasks.
+     *
+     * @param idle_hook Function to call, NULL for none
+     */
+    void setIdleHook(void (*idle_hook)(void));
+
+    /**
+     * @brief   Set the function that puts the CPU to sleep (e.g. WFI) on idle passes of run()
+     *          without background tasks. It is passed getTicksToNextDeadline(), and must
+     *          return on the next interrupt at the latest, so that events are not delayed.
+     *
+     * @note    It is called with interrupts enabled, so an interrupt may post an event or
+     *          release a task after run() checked for pending work. Mask interrupts, check
+     *          isIdle(), and only then execute WFI, which still wakes on a pending interrupt,
+     *          before unmasking them again.
+     *
+     * @param sleep_handler Function to call, NULL to never sleep
+     */
+    void setSleepHandler(void (*sleep_handler)(uint32_t ticks));
+
+    /**
+     * @brief   Whether no event is posted and no task is due, for the sleep handler to
+     *          check with interrupts masked right before sleeping.
+     *
+     * @return true     When the CPU may sleep until the next interrupt
+     */
+    bool isIdle(void);
+
+    /**
+     * @brief   Get the system ticks spent on idle passes of run() since init(),
+     *          including background tasks, the idle hook and sleep.
+     *
+     * @return tick_t Idle time in system ticks
+     */
+    tick_t getIdleTicks(void);
+
+    /**
+     * @brief Get the number of events dropped by post() because the queue was full
+     *
+     * @return uint32_t Number of dropped events
+     */
+    uint32_t getEventOverflowCount(void);
+
+    /**
+     * @brief   Copy [task] into a free slot of the task table bound by init(), which is
+     *          then used as a pool: slots made with the default Task constructor are free.
+     *          The task is due on the next run(). The active dispatch structure is
+     *          updated in place, in O(log n) at most, except DISPATCH_PRIORITY which
+     *          moves the slot in its order in O(n) when its priority changed.
+     *          Call this, and the other task pool functions, from the main loop only.
+     *
+     * @note    Continuous tasks cannot be added, use background tasks instead.
+     *          A slot removed by a task function while run() holds its entry, or a continuous
+     *          task removed in DISPATCH_HEAP, is reused from the next run() on.
+     *
+     * @param task Task to copy
+     * @return Task* Slot holding the task, NULL when the pool is full or the task
+     *               has no function or an interval of 0
+     */
+    Task* addTask(const Task& task);
+
+    /**
+     * @brief   Stop [task] and return its slot to the pool.
+     *          DISPATCH_HEAP and DISPATCH_WHEEL search their queue for its entry, in O(n).
+     *
+     * @param task Task of the bound task table
+     * @return true     On success
+     * @return false    When [task] is not in use in the bound task table
+     */
+    bool removeTask(Task& task);
+
+    /**
+     * @brief Stop running [task] until enableTask()
+     *
+     * @param task Task of the bound task table
+     */
+    void disableTask(Task& task);
+
+    /**
+     * @brief Run [task] again, one interval from now
+     *
+     * @param task Task of the bound task table
+     */
+    void enableTask(Task& task);
+
+    /**
+     * @brief Stop running [task] until resumeTask()
+     *
+     * @param task Task of the bound task table
+     */
+    void suspendTask(Task& task);
+
+    /**
+     * @brief   Run [task] again on its original release grid, from the first release
+     *          that is not in the past. The releases while suspended are skipped.
+     *
+     * @param task Task of the bound task table
+     */
+    void resumeTask(Task& task);
+
+    /**
+     * @brief   Start a software timer: [func] runs once from run(), [delay] ticks from now,
+     *          then its slot returns to the task pool (see addTask()). A timer is a task,
+     *          so it is kept in the active dispatch structure and shows up in statistics
+     *          and traces. Deadline misses and the release policy do not apply to it.
+     *
+     * @param func  Function to run
+     * @param delay System ticks until it runs, less than half the tick_t range
+     * @return Task* Timer handle for cancelTimer(), valid until [func] is called,
+     *               NULL when the pool is full
+     */
+    Task* startTimer(void (*func)(), const tick_t delay);
+
+    /**
+     * @brief Start a software timer whose function receives [context]
+     *
+     * @param context_func  Function to run with [context]
+     * @param context       Pointer passed to [context_func]
+     * @param delay         System ticks until it runs, less than half the tick_t range
+     * @return Task* Timer handle for cancelTimer(), NULL when the pool is full
+     */
+    Task* startTimer(void (*context_func)(void*), void* const context, const tick_t delay);
+
+    /**
+     * @brief Stop a software timer before it runs, and return its slot to the pool, see removeTask()
+     *
+     * @param timer Handle returned by startTimer()
+     * @return true     On success
+     * @return false    When [timer] already ran or was cancelled
+     */
+    bool cancelTimer(Task& timer);
+
+#ifdef SCHEDULER_ENABLE_PRIORITY
+    /**
+     * @brief   Assigns rate-monotonic priorities: the shorter the interval,
+     *          the higher the priority. Continuous tasks get the lowest priority.
+     *          With more than 256 tasks, neighbouring ranks share a priority.
+     *
+     * @param taskTable Array of tasks to assign priorities to
+     * @param num_tasks Number of members in array [taskTable]
+     */
+    static void assignRateMonotonicPriorities(Task* const taskTable, const uint16_t num_tasks);
+#endif
+
+#ifdef SCHEDULER_ENABLE_PHASE
+    /**
+     * @brief   Assigns phase offsets that spread the releases of the periodic tasks, so that
+     *          tasks with harmonic intervals do not all run on the same tick. Greedy: by
+     *          increasing interval, each task takes the phase whose releases meet the
+     *          least load of the tasks already placed, weighted by their budget (1 when
+     *          no budget is set, or without SCHEDULER_ENABLE_BUDGET). Call it before init().
+     *
+     * @param taskTable     Array of tasks to assign phases to
+     * @param num_tasks     Number of members in array [taskTable]
+     * @param granularity   Phases are multiples of it, typically the systick interval
+     */
+    static void assignPhaseOffsets(Task* const taskTable, const uint16_t num_tasks, const tick_t granularity);
+#endif
+
+    /**
+     * @brief Get the active dispatch mode
+     *
+     * @return DispatchMode Active dispatch mode
+     */
+    DispatchMode getDispatchMode(void);
 
 private:
     uint32_t systick_interval_ = 1;
+#ifdef SCHEDULER_64BIT_TICK
+    volatile uint32_t tick_seq_ = 0;        /*!< Incremented after every update of sys_tick_ctr_ */
+#endif
+    ReleasePolicy release_policy_ = RELEASE_FREE_RUNNING;   /*!< Computes the next release of periodic tasks */
+
+    void (*fault_handler_)(Task& task, TimingFault fault) = NULL;   /*!< Called on timing faults */
+    uint32_t deadline_miss_count_ = 0;      /*!< Deadline misses since init() */
+#ifdef SCHEDULER_ENABLE_BUDGET
+    uint32_t budget_overrun_count_ = 0;     /*!< Budget overruns since init() */
+#endif
     uint16_t num_tasks_ = 0;                /*!< Number of tasks in the task table */
     Task* task_table_ = NULL;               /*!< Pointer to the task table */
 
+    DispatchMode dispatch_mode_ = DISPATCH_LINEAR;  /*!< Active dispatch mode */
+    uint16_t free_head_ = POOL_END;         /*!< First free slot of the task table */
+#ifdef SCHEDULER_HAS_DISPATCH_STORAGE
+    uint16_t dispatch_capacity_ = 0;        /*!< Number of tasks the dispatch storage can hold */
+
+    bool usesDispatchStorage(void);
+#endif
+
+#ifdef SCHEDULER_ENABLE_HEAP
+    DispatchEntry* dispatch_queue_ = NULL;  /*!< Heap storage, continuous tasks at the end */
+    uint16_t continuous_count_ = 0;         /*!< Continuous tasks at the end of dispatch_queue_ */
+    uint16_t heap_size_ = 0;                /*!< Periodic tasks in the heap after the continuous ones */
+
+    void runHeap(void);
+    void buildHeap(void);
+#endif
+
+#if defined(SCHEDULER_ENABLE_HEAP) || defined(SCHEDULER_ENABLE_BITMAP)
+    void siftDown(DispatchEntry* const heap, const uint16_t size, uint16_t pos);
+    void siftUp(DispatchEntry* const heap, uint16_t pos);
+#endif
+
+#ifdef SCHEDULER_ENABLE_PRIORITY
+    uint16_t* dispatch_order_ = NULL;       /*!< Task indices by decreasing priority */
+
+    void runPriority(void);
+    void buildOrder(void);
+    void reorderTask(const uint16_t index);
+#endif
+
+#ifdef SCHEDULER_ENABLE_EDF
+    void runEdf(void);
+#endif
+
+#ifdef SCHEDULER_ENABLE_BITMAP
+    volatile uint32_t* ready_released_ = NULL;      /*!< Written by tick() only */
+    volatile uint32_t* ready_acknowledged_ = NULL;  /*!< Written by run() only */
+    uint32_t* ready_scanned_ = NULL;        /*!< ready_acknowledged_ as last seen, written by tick() only */
+    DispatchEntry* ready_pending_ = NULL;   /*!< Releases of the tasks that are not ready, written by tick() only */
+    uint16_t ready_pending_size_ = 0;       /*!< Number of entries in ready_pending_ */
+    volatile uint32_t ready_runs_ = 0;      /*!< Tasks acknowledged by run(), written by run() only */
+    uint32_t ready_seen_ = 0;               /*!< ready_runs_ at the last scan, written by tick() only */
+    volatile uint32_t ready_rescans_ = 0;   /*!< Full scans requested by the task pool, written by the main loop only */
+    uint32_t ready_rescanned_ = 0;          /*!< ready_rescans_ at the last full scan, written by tick() only */
+
+    void runBitmap(void);
+    void buildBitmap(void);
+    void updateReady(const tick_t now);
+    void rescanReady(const tick_t now);
+    void releaseReady(const uint16_t index, const tick_t now);
+#endif
+
+#ifdef SCHEDULER_ENABLE_RELEASE_ARRAY
+    tick_t* release_array_ = NULL;          /*!< Next release of each task, indexed like the task table */
+
+    void runReleaseArray(void);
+    void buildReleaseArray(void);
+    tick_t nextRelease(const Task& task, const tick_t now);
+#endif
+
+#ifdef SCHEDULER_ENABLE_WHEEL
+    uint16_t* wheel_slots_ = NULL;          /*!< Slot list heads, level by level */
+    uint16_t* wheel_links_ = NULL;          /*!< Next task in the same slot, indexed by task */
+    tick_t wheel_time_ = 0;                 /*!< Start tick of the current wheel slot */
+    uint32_t wheel_now_ = 0;                /*!< Current wheel slot count */
+    uint8_t wheel_shift_ = 0;               /*!< log2 of the wheel slot width in ticks */
+
+    void runWheel(void);
+    void buildWheel(void);
+    void wheelInsert(const uint16_t task);
+    void wheelCollect(uint16_t* const slot, uint16_t& list);
+    void wheelCascade(uint16_t* const slot);
+    void wheelSkip(const tick_t num_slots);
+#endif
+
+    Task* event_tasks_ = NULL;              /*!< Tasks released by post() */
+    uint16_t num_event_tasks_ = 0;          /*!< Number of tasks in event_tasks_ */
+    uint16_t* event_storage_ = NULL;        /*!< Ring of posted event task indices */
+    uint16_t event_mask_ = 0;               /*!< Capacity of event_storage_ minus one */
+    volatile uint16_t event_head_ = 0;      /*!< Next entry to post, written by post() only */
+    volatile uint16_t event_tail_ = 0;      /*!< Next entry to run, written by run() only */
+    volatile uint32_t event_overflow_count_ = 0;    /*!< Events dropped by post() */
+
+    Task* background_tasks_ = NULL;         /*!< Tasks run on idle passes */
+    uint16_t num_background_tasks_ = 0;     /*!< Number of tasks in background_tasks_ */
+    void (*idle_hook_)(void) = NULL;        /*!< Called on idle passes */
+    void (*sleep_handler_)(uint32_t ticks) = NULL;  /*!< Sleeps on idle passes */
+    uint32_t dispatch_count_ = 0;           /*!< Task runs, to detect idle passes */
+    tick_t idle_ticks_ = 0;                 /*!< Ticks spent on idle passes since init() */
+
+#ifdef SCHEDULER_HAS_CYCLE_COUNTER
+    uint32_t (*cycle_counter_)(void) = NULL;   /*!< Cycle counter used for runtimes */
+#endif
+
+#ifdef SCHEDULER_HAS_CYCLE_COUNTER
+    uint32_t readClock(void);
+#endif
+
+#ifdef SCHEDULER_ENABLE_TRACE
+    TraceEvent* trace_storage_ = NULL;      /*!< Trace ring buffer */
+    uint32_t trace_mask_ = 0;               /*!< Capacity of trace_storage_ minus one */
+    volatile uint32_t trace_head_ = 0;      /*!< Events recorded, the next one goes to trace_head_ & trace_mask_ */
+    volatile bool trace_claiming_ = false;  /*!< Set while run() moves trace_head_ */
+    volatile uint32_t trace_deferred_ = 0;  /*!< Ticks that tick() could not record, written by tick() only */
+    uint32_t trace_deferred_seen_ = 0;      /*!< trace_deferred_ already recorded by run() */
+
+    void trace(const uint8_t type, const uint8_t source, const uint16_t task);
+    void traceTask(const Task& task, const uint8_t type);
+    void traceTick(void);
+#endif
+
+#ifdef SCHEDULER_ENABLE_LOAD
+    uint16_t load_history_[SCHEDULER_LOAD_HISTORY];  /*!< CPU load of each completed second, in per mille */
+    uint8_t load_index_ = 0;                /*!< Next entry of load_history_ */
+    uint8_t load_seconds_ = 0;              /*!< Valid entries in load_history_ */
+    tick_t load_start_ = 0;                 /*!< Start tick of the current second */
+    uint32_t load_start_clock_ = 0;         /*!< readClock() at the start of the current second */
+    uint32_t load_busy_ = 0;                /*!< Time spent in tasks in the current second */
+    uint32_t load_clock_rate_ = 0;          /*!< readClock() counts per second, 0 until a second closed on time */
+
+    void accountLoad(Task& task, const uint32_t start);
+    void updateLoad(void);
+    void resetLoad(void);
+#endif
+
+#ifdef SCHEDULER_ENABLE_STATS
+    void recordRuntime(TaskStats& stats, const uint32_t start);
+#endif
+
+    void dispatch(Task& task, const tick_t sysctr);
+    void reportFault(Task& task, const TimingFault fault);
+    bool hasPendingEvents(void);
+    void runEvents(void);
+    void dispatchUntimed(Task& task, const tick_t sysctr);
+    void runIdle(void);
+    bool findNextRelease(tick_t& remaining);
+    void buildDispatch(void);
+    void buildPool(void);
+    void releaseSlot(const uint16_t index);
+    void dropTask(const uint16_t index);
+    void enqueueTask(const uint16_t index);
+    bool dequeueTask(const uint16_t index);
+    Task* insertTask(const Task& task, const tick_t release, const uint8_t state);
+    void runLinear(void);
+
 };
@@ -0,0 +1,181 @@
+/**
+ * @file StaticScheduler.hpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief A scheduler whose task table is fixed at compile time.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Make sure UINT32_MAX is present*/
+#ifndef UINT32_MAX
+    #define UINT32_MAX  (0xFFFFFFFF)
+#endif
+
+#ifndef NULL
+    #define NULL (0)
+#endif
+
+/**
+ * @brief A single task of a StaticScheduler.
+ * The function is a template argument, so the scheduler calls it directly
+ * and the compiler is free to inline it.
+ *
+ * @tparam FUNC Function to be ran by the scheduler
+ * @tparam INTERVAL Interval (typically in microseconds) that the scheduler runs the function.
+ *                  An interval of 0 runs the function on every run().
+ */
+template <void (*FUNC)(), uint32_t INTERVAL>
+struct StaticTask {
+    static_assert(FUNC != NULL, "StaticTask function must not be NULL");
+
+    static const uint32_t interval = INTERVAL;
+
+    static void func(void) {
+        FUNC();
+    }
+};
+
+/**
+ * @brief   A scheduler whose task table is a list of StaticTask types.
+ *          run() is unrolled at compile time, tasks are called without going through
+ *          a function pointer, and nothing has to be checked at init().
+ *          Tasks are released like Scheduler::RELEASE_FREE_RUNNING.
+ *          Use Scheduler when the task table has to change at runtime.
+ *
+ * @code
+ * StaticScheduler< StaticTask<blink, 500000>, StaticTask<poll, 1000> > scheduler;
+ * @endcode
+ *
+ * @tparam TASKS StaticTask types, ran in the listed order
+ */
+template <typename... TASKS>
+class StaticScheduler {
+public:
+    static_assert(sizeof...(TASKS) > 0, "StaticScheduler needs at least one task");
+
+    static const uint16_t num_tasks = sizeof...(TASKS);    /*!< Number of tasks in the task table */
+
+    /**
+     * @brief System tick count, typically represented in microseconds.
+     * Public access is given to allow for control within ISR without a function call.
+     * Do not decrement this value.
+     */
+    volatile uint32_t sys_tick_ctr_ = 0;    /*!< System tick counter */
+
+    StaticScheduler() {
+        init(1);
+    }
+
+    /**
+     * @brief   Initializes the scheduler object so that every task
+     *          is called on the first instance of run().
+     *
+     * @param systick_interval  Actual duration of a single systick, typically in microseconds
+     */
+    void init(const uint32_t systick_interval) {
+        systick_interval_ = systick_interval;
+        initFrom<0>(TaskList<TASKS...>());
+        sys_tick_ctr_ = 0;
+    }
+
+    /**
+     * @brief Runs the tasks that are due.
+     *
+     */
+    void run(void) {
+        runFrom<0>(TaskList<TASKS...>());
+    }
+
+    /**
+     * @brief Increments the system tick by the systick_interval.
+     *
+     * @return uint32_t Current tick
+     */
+    uint32_t tick(void) {
+        return sys_tick_ctr_ += systick_interval_;
+    }
+
+    /**
+     * @brief Get the system tick counter value
+     *
+     * @return uint32_t System Tick Counter Value
+     */
+    uint32_t getTickCount(void) {
+        return sys_tick_ctr_;
+    }
+
+    /**
+     * @brief Set the system tick interval
+     *
+     * @param systick_interval Duration of a single systick, typically in microseconds
+     */
+    void setTickInterval(const uint32_t systick_interval) {
+        systick_interval_ = systick_interval;
+    }
+
+private:
+    template <typename... LIST>
+    struct TaskList {};
+
+    uint32_t systick_interval_ = 1;
+    uint32_t last_called_[sizeof...(TASKS)];
+
+    template <uint16_t I>
+    void initFrom(TaskList<>) {}
+
+    template <uint16_t I, typename TASK, typename... REST>
+    void initFrom(TaskList<TASK, REST...>) {
+        /* Called on first instance of run(), as Scheduler::init() does */
+        last_called_[I] = UINT32_MAX - TASK::interval + 1;
+        initFrom<I + 1>(TaskList<REST...>());
+    }
+
+    template <uint16_t I>
+    void runFrom(TaskList<>) {}
+
+    template <uint16_t I, typename TASK, typename... REST>
+    void runFrom(TaskList<TASK, REST...>) {
+        /* obtain a copy of the sys_tick_ctr at the execution to avoid concurrency */
+        const uint32_t sysctr = sys_tick_ctr_;
+
+        if( TASK::interval == 0 )
+        {
+            /* Run continuous tasks */
+            TASK::func();
+        }
+        else if( sysctr - last_called_[I] >= TASK::interval )
+        {
+            /* Run the tasks that are already due */
+            TASK::func();
+            last_called_[I] = sysctr;
+        }
+
+        runFrom<I + 1>(TaskList<REST...>());
+    }
+};
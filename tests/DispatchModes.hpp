@@ -0,0 +1,89 @@
+/**
+ * @file DispatchModes.hpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Storage for every dispatch mode, shared by the tests.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "Scheduler.hpp"
+
+/* Number of values of Scheduler::DispatchMode */
+static const int NUM_DISPATCH_MODES = (int)Scheduler::DISPATCH_RELEASE_ARRAY + 1;
+
+/**
+ * @brief Storage of every dispatch mode, so that a test can run in each of them
+ *
+ * @tparam NUM_TASKS Size of the task table
+ */
+template <uint16_t NUM_TASKS>
+struct DispatchStorage {
+    Scheduler::DispatchEntry queue[NUM_TASKS];
+    Scheduler::TimingWheel<NUM_TASKS> wheel;
+    uint16_t order[NUM_TASKS];
+    Scheduler::ReadyBitmap<NUM_TASKS> bitmap;
+    Scheduler::ReleaseArray<NUM_TASKS> releases;
+
+    /**
+     * @brief Select [mode] on [scheduler]
+     *
+     * @return true When the mode was selected
+     */
+    bool use(Scheduler& scheduler, const Scheduler::DispatchMode mode) {
+        switch( mode )
+        {
+            case Scheduler::DISPATCH_HEAP:
+                return scheduler.useHeapDispatch(queue, NUM_TASKS);
+            case Scheduler::DISPATCH_WHEEL:
+                return scheduler.useWheelDispatch(wheel);
+            case Scheduler::DISPATCH_PRIORITY:
+                return scheduler.usePriorityDispatch(order, NUM_TASKS);
+            case Scheduler::DISPATCH_EDF:
+                scheduler.useEdfDispatch();
+                return true;
+            case Scheduler::DISPATCH_BITMAP:
+                return scheduler.useBitmapDispatch(bitmap);
+            case Scheduler::DISPATCH_RELEASE_ARRAY:
+                return scheduler.useReleaseArrayDispatch(releases);
+            default:
+                scheduler.useLinearDispatch();
+                return true;
+        }
+    }
+};
+
+/* Task function counting its runs in the uint32_t given as context */
+static inline void countRun(void* context)
+{
+    ++*static_cast<uint32_t*>(context);
+}
+
+/* Deterministic pseudo-random numbers, so that every mode sees the same sequence */
+static inline uint32_t nextRandom(uint32_t& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
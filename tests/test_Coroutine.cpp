@@ -0,0 +1,150 @@
+/**
+ * @file test_Coroutine.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Tests of the stackless coroutines run as Scheduler tasks.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Coroutine.hpp"
+#include "Scheduler.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+/* Scheduler the delays of the coroutines count on */
+static Scheduler* coroutine_scheduler = NULL;
+
+/* Coroutine recording the last step it reached */
+class Stepper : public Coroutine {
+public:
+    Stepper(void) : ready(false), step(0), runs(0) {}
+
+    void run(void) {
+        ++runs;
+        COROUTINE_BEGIN();
+        step = 1;
+        COROUTINE_YIELD();
+        step = 2;
+        COROUTINE_WAIT_UNTIL(ready);
+        step = 3;
+        COROUTINE_DELAY(*coroutine_scheduler, 5);
+        step = 4;
+        COROUTINE_END();
+    }
+
+    /* Whether [now] reached [tick], as seen by the waits */
+    static bool reached(const Scheduler::tick_t now, const Scheduler::tick_t tick) {
+        return isReached(now, tick);
+    }
+
+    bool ready;
+    uint8_t step;
+    uint32_t runs;
+};
+
+TEST_GROUP(Coroutine)
+{
+    Scheduler scheduler;
+    Stepper stepper;
+    Scheduler::Task table[1];
+
+    void setup()
+    {
+        coroutine_scheduler = &scheduler;
+        table[0] = Scheduler::Task::bind<Stepper, &Stepper::run>(&stepper, 1);
+        CHECK_TRUE(scheduler.init(table, 1, 1));
+    }
+
+    void runTicks(const int num_ticks)
+    {
+        for( int i = 0; i < num_ticks; ++i )
+        {
+            scheduler.tick();
+            scheduler.run();
+        }
+    }
+};
+
+TEST(Coroutine, YieldResumesOnTheNextRun)
+{
+    scheduler.run();
+    LONGS_EQUAL(1, stepper.step);
+
+    runTicks(1);
+    LONGS_EQUAL(2, stepper.step);
+    CHECK_FALSE(stepper.isDone());
+}
+
+TEST(Coroutine, WaitUntilPollsTheCondition)
+{
+    scheduler.run();
+    runTicks(3);
+    LONGS_EQUAL(2, stepper.step);
+    LONGS_EQUAL(4, stepper.runs);
+
+    stepper.ready = true;
+    runTicks(1);
+    LONGS_EQUAL(3, stepper.step);
+}
+
+TEST(Coroutine, DelayWaitsForTheTicks)
+{
+    stepper.ready = true;
+    scheduler.run();
+    runTicks(1);
+    LONGS_EQUAL(3, stepper.step);
+
+    runTicks(4);
+    LONGS_EQUAL(3, stepper.step);
+
+    runTicks(1);
+    LONGS_EQUAL(4, stepper.step);
+    CHECK_TRUE(stepper.isDone());
+}
+
+TEST(Coroutine, FinishedBodyWaitsForRestart)
+{
+    stepper.ready = true;
+    scheduler.run();
+    runTicks(6);
+    CHECK_TRUE(stepper.isDone());
+
+    runTicks(3);
+    LONGS_EQUAL(4, stepper.step);
+
+    stepper.restart();
+    CHECK_FALSE(stepper.isDone());
+    runTicks(1);
+    LONGS_EQUAL(1, stepper.step);
+}
+
+TEST(Coroutine, WaitsSurviveTheTickWrapAround)
+{
+    const Scheduler::tick_t max = ~(Scheduler::tick_t)0;
+
+    CHECK_TRUE(Stepper::reached(max, max));
+    CHECK_TRUE(Stepper::reached(2, max - 1));
+    CHECK_FALSE(Stepper::reached(max - 1, 2));
+    CHECK_FALSE(Stepper::reached(max, 0));
+}
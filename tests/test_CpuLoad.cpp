@@ -0,0 +1,172 @@
+/**
+ * @file test_CpuLoad.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Tests of the CPU load monitor, measured with the system tick.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Scheduler.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+#ifdef SCHEDULER_ENABLE_LOAD
+
+/* One system tick per millisecond */
+static const uint32_t SYSTICK = 1000;
+static const uint32_t TICKS_PER_SECOND = SCHEDULER_LOAD_TICKS_PER_SECOND / SYSTICK;
+
+/* Cycle counter of a 1 GHz CPU, which wraps in less than 5 seconds */
+static const uint32_t CYCLES_PER_TICK = 1000000;
+static uint32_t cycles = 0;
+
+static uint32_t readCycles(void)
+{
+    return cycles;
+}
+
+static Scheduler* load_scheduler = NULL;
+
+/* Task function that runs for [ticks] system ticks */
+static void spin(const uint32_t ticks)
+{
+    for( uint32_t i = 0; i < ticks; ++i )
+    {
+        cycles += CYCLES_PER_TICK;
+        load_scheduler->tick();
+    }
+}
+
+static void idleTask(void)
+{
+}
+
+static void oneTickTask(void)
+{
+    spin(1);
+}
+
+static void backgroundTask(void)
+{
+    spin(6);
+}
+
+TEST_GROUP(CpuLoad)
+{
+    Scheduler scheduler;
+
+    void setup()
+    {
+        load_scheduler = &scheduler;
+    }
+
+    void runFor(const uint32_t ticks)
+    {
+        const Scheduler::tick_t end = scheduler.getTickCount() + (Scheduler::tick_t)ticks * SYSTICK;
+        while( scheduler.getTickCount() < end )
+        {
+            scheduler.run();
+            spin(1);
+        }
+    }
+};
+
+TEST(CpuLoad, HalfBusySecond)
+{
+    Scheduler::Task table[] = { Scheduler::Task(oneTickTask, 2 * SYSTICK) };
+    CHECK_TRUE(scheduler.init(table, 1, SYSTICK));
+
+    runFor(TICKS_PER_SECOND + 2);
+    LONGS_EQUAL(500, scheduler.getCpuLoad(Scheduler::LOAD_1S));
+}
+
+TEST(CpuLoad, BackgroundTasksCountAsIdle)
+{
+    Scheduler::Task table[] = { Scheduler::Task(idleTask, 100 * SYSTICK) };
+    Scheduler::Task background[] = { Scheduler::Task(backgroundTask, 0) };
+    CHECK_TRUE(scheduler.init(table, 1, SYSTICK));
+    CHECK_TRUE(scheduler.useBackgroundTasks(background, 1));
+
+    runFor(TICKS_PER_SECOND + 10);
+    LONGS_EQUAL(0, scheduler.getCpuLoad(Scheduler::LOAD_1S));
+    LONGS_EQUAL(0, background[0].load);
+}
+
+TEST(CpuLoad, LongSleepClosesEverySecond)
+{
+    Scheduler::Task table[] = { Scheduler::Task(oneTickTask, 2 * SYSTICK) };
+    CHECK_TRUE(scheduler.init(table, 1, SYSTICK));
+
+    runFor(TICKS_PER_SECOND + 2);
+    LONGS_EQUAL(500, scheduler.getCpuLoad(Scheduler::LOAD_1S));
+
+    /* Nine idle seconds in one sleep */
+    scheduler.advanceTicks(9 * TICKS_PER_SECOND);
+    scheduler.run();
+
+    LONGS_EQUAL(0, scheduler.getCpuLoad(Scheduler::LOAD_1S));
+    LONGS_EQUAL(50, scheduler.getCpuLoad(Scheduler::LOAD_10S));
+}
+
+TEST(CpuLoad, LongSleepOverAWrappingCycleCounter)
+{
+    Scheduler::Task table[] = { Scheduler::Task(oneTickTask, 2 * SYSTICK) };
+    CHECK_TRUE(scheduler.init(table, 1, SYSTICK));
+    scheduler.setCycleCounter(readCycles);
+
+    runFor(TICKS_PER_SECOND + 2);
+    LONGS_EQUAL(500, scheduler.getCpuLoad(Scheduler::LOAD_1S));
+
+    /* The counter wraps during the sleep and ends up just past where it started */
+    scheduler.advanceTicks(4295);
+    cycles += 4295 * CYCLES_PER_TICK;
+    scheduler.run();
+
+    LONGS_EQUAL(0, scheduler.getCpuLoad(Scheduler::LOAD_1S));
+    LONGS_EQUAL(100, scheduler.getCpuLoad(Scheduler::LOAD_10S));
+    LONGS_EQUAL(0, table[0].load);
+}
+
+TEST(CpuLoad, ResetClearsEventTaskLoad)
+{
+    static Scheduler::EventQueue<4> queue;
+    Scheduler::Task table[] = { Scheduler::Task(idleTask, 100 * SYSTICK) };
+    Scheduler::Task events[] = { Scheduler::Task(oneTickTask, 0) };
+    CHECK_TRUE(scheduler.init(table, 1, SYSTICK));
+    CHECK_TRUE(scheduler.useEventQueue(events, 1, queue));
+
+    for( uint32_t i = 0; i < TICKS_PER_SECOND; ++i )
+    {
+        scheduler.post(0);
+        scheduler.run();
+    }
+    scheduler.run();
+    CHECK(events[0].load > 0);
+
+    /* Changing the clock restarts the measurement */
+    scheduler.setCycleCounter(readCycles);
+    LONGS_EQUAL(0, events[0].load);
+}
+
+#endif
@@ -0,0 +1,668 @@
+/**
+ * @file test_Lean_Scheduler.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Tests of the task table dispatch: init, every dispatch mode, release policies and tick wrap-around.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "DispatchModes.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+static const uint16_t NUM_TASKS = 20;
+
+static uint32_t plain_runs = 0;
+
+static void plainTask(void)
+{
+    ++plain_runs;
+}
+
+/* Names of the tasks in the order they ran */
+static char task_names[] = "ABC";
+static char run_order[8];
+static uint8_t num_logged = 0;
+
+/* Task function logging the name given as context */
+static void logRun(void* context)
+{
+    if( num_logged + 1 < (int)sizeof(run_order) )
+    {
+        run_order[num_logged++] = *static_cast<char*>(context);
+        run_order[num_logged] = '\0';
+    }
+}
+
+TEST_GROUP(LeanScheduler)
+{
+    Scheduler scheduler;
+
+    void setup()
+    {
+        plain_runs = 0;
+        run_order[0] = '\0';
+        num_logged = 0;
+    }
+};
+
+TEST(LeanScheduler, InitRejectsNullTable)
+{
+    CHECK_FALSE(scheduler.init(NULL, 1, 1000));
+}
+
+TEST(LeanScheduler, ZeroTickIntervalIsRejected)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 5000) };
+
+    CHECK_FALSE(scheduler.init(table, 1, 0));
+    CHECK_TRUE(scheduler.init(table, 1, 1000));
+    CHECK_FALSE(scheduler.setTickInterval(0));
+
+    scheduler.run();
+    LONGS_EQUAL(5, scheduler.getTicksToNextDeadline());
+}
+
+TEST(LeanScheduler, InitRejectsTaskWithoutFunction)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 10), Scheduler::Task((void (*)())NULL, 10) };
+
+    CHECK_FALSE(scheduler.init(table, 2, 1));
+}
+
+TEST(LeanScheduler, InitRejectsPhaseOfAWholeInterval)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 10) };
+    table[0].phase = 10;
+
+    CHECK_FALSE(scheduler.init(table, 1, 1));
+}
+
+TEST(LeanScheduler, TaskRunsOnFirstRunThenEveryInterval)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 10) };
+    CHECK_TRUE(scheduler.init(table, 1, 1));
+
+    scheduler.run();
+    LONGS_EQUAL(1, plain_runs);
+
+    for( int i = 0; i < 9; ++i )
+    {
+        scheduler.tick();
+        scheduler.run();
+    }
+    LONGS_EQUAL(1, plain_runs);
+
+    scheduler.tick();
+    scheduler.run();
+    LONGS_EQUAL(2, plain_runs);
+}
+
+TEST(LeanScheduler, PhaseDelaysTheFirstRelease)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 10) };
+    table[0].phase = 4;
+    CHECK_TRUE(scheduler.init(table, 1, 1));
+
+    for( int i = 0; i < 4; ++i )
+    {
+        scheduler.run();
+        scheduler.tick();
+    }
+    LONGS_EQUAL(0, plain_runs);
+
+    scheduler.run();
+    LONGS_EQUAL(1, plain_runs);
+}
+
+TEST(LeanScheduler, PhaseOffsetsSpreadTasksOfOneInterval)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 4), Scheduler::Task(plainTask, 4),
+                                Scheduler::Task(plainTask, 4), Scheduler::Task(plainTask, 4) };
+    Scheduler::assignPhaseOffsets(table, 4, 1);
+
+    LONGS_EQUAL(0, table[0].phase);
+    LONGS_EQUAL(1, table[1].phase);
+    LONGS_EQUAL(2, table[2].phase);
+    LONGS_EQUAL(3, table[3].phase);
+
+    /* One task is released per tick */
+    CHECK_TRUE(scheduler.init(table, 4, 1));
+    for( int i = 0; i < 8; ++i )
+    {
+        const uint32_t before = plain_runs;
+        scheduler.run();
+        LONGS_EQUAL(before + 1, plain_runs);
+        scheduler.tick();
+    }
+}
+
+TEST(LeanScheduler, PhaseOffsetsPlaceShorterIntervalsFirst)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 8), Scheduler::Task(plainTask, 4),
+                                Scheduler::Task(plainTask, 4) };
+    Scheduler::assignPhaseOffsets(table, 3, 1);
+
+    LONGS_EQUAL(2, table[0].phase);
+    LONGS_EQUAL(0, table[1].phase);
+    LONGS_EQUAL(1, table[2].phase);
+}
+
+TEST(LeanScheduler, PhaseOffsetsFollowTheGranularity)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 4), Scheduler::Task(plainTask, 4),
+                                Scheduler::Task(plainTask, 4) };
+    Scheduler::assignPhaseOffsets(table, 3, 2);
+
+    LONGS_EQUAL(0, table[0].phase);
+    LONGS_EQUAL(2, table[1].phase);
+    LONGS_EQUAL(0, table[2].phase);
+}
+
+TEST(LeanScheduler, TicksToNextDeadline)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 5000) };
+    CHECK_TRUE(scheduler.init(table, 1, 1000));
+
+    LONGS_EQUAL(0, scheduler.getTicksToNextDeadline());
+    scheduler.run();
+    LONGS_EQUAL(5, scheduler.getTicksToNextDeadline());
+
+    scheduler.advanceTicks(5);
+    LONGS_EQUAL(0, scheduler.getTicksToNextDeadline());
+    scheduler.run();
+    LONGS_EQUAL(2, plain_runs);
+}
+
+#ifdef SCHEDULER_64BIT_TICK
+TEST(LeanScheduler, TickCountGoesPastThe32BitRange)
+{
+    /* 5000 s at 1 us per count, more than a 32-bit tick can hold */
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, (Scheduler::tick_t)5000000000ULL) };
+    CHECK_TRUE(scheduler.init(table, 1, 1000));
+
+    scheduler.run();
+    LONGS_EQUAL(1, plain_runs);
+    LONGS_EQUAL(5000000, scheduler.getTicksToNextDeadline());
+
+    scheduler.advanceTicks(4999999);
+    CHECK(scheduler.getTickCount() > UINT32_MAX);
+    scheduler.run();
+    LONGS_EQUAL(1, plain_runs);
+
+    scheduler.tick();
+    scheduler.run();
+    LONGS_EQUAL(2, plain_runs);
+    CHECK(scheduler.getTickCount() == (Scheduler::tick_t)5000000000ULL);
+}
+#endif
+
+TEST_GROUP(DispatchModes)
+{
+    Scheduler::Task table[NUM_TASKS];
+    uint32_t runs[NUM_DISPATCH_MODES][NUM_TASKS];
+
+    void setup()
+    {
+        for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+        {
+            for( uint16_t i = 0; i < NUM_TASKS; ++i )
+                runs[mode][i] = 0;
+        }
+    }
+
+    /* Random intervals, one continuous task, the same for every mode */
+    void makeTable(uint32_t* const counters)
+    {
+        uint32_t random = 7;
+
+        for( uint16_t i = 0; i < NUM_TASKS; ++i )
+        {
+            const uint32_t interval = (i == 3) ? 0 :
+                (nextRandom(random) % 5 == 0) ? nextRandom(random) % 100000000 : nextRandom(random) % 50000 + 1;
+            table[i] = Scheduler::Task(countRun, &counters[i], interval);
+        }
+    }
+
+    /* Ticks with irregular gaps between the passes of run() */
+    void drive(Scheduler& scheduler, const uint32_t iterations)
+    {
+        uint32_t random = 11;
+
+        for( uint32_t k = 0; k < iterations; ++k )
+        {
+            scheduler.tick();
+            if( nextRandom(random) % 7 == 0 )
+                continue;
+            if( nextRandom(random) % 50 == 0 )
+            {
+                const uint32_t gap = nextRandom(random) % 300;
+                for( uint32_t j = 0; j < gap; ++j )
+                    scheduler.tick();
+            }
+            scheduler.run();
+        }
+    }
+
+    void runEveryMode(const Scheduler::ReleasePolicy policy)
+    {
+        for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+        {
+            static DispatchStorage<NUM_TASKS> storage;
+            Scheduler scheduler;
+
+            makeTable(runs[mode]);
+            CHECK_TRUE(storage.use(scheduler, (Scheduler::DispatchMode)mode));
+            CHECK_TRUE(scheduler.init(table, NUM_TASKS, 1000));
+            scheduler.setReleasePolicy(policy);
+
+            drive(scheduler, 100000);
+        }
+    }
+
+    void checkSameRunsAsLinear(void)
+    {
+        for( int mode = 1; mode < NUM_DISPATCH_MODES; ++mode )
+        {
+            for( uint16_t i = 0; i < NUM_TASKS; ++i )
+                LONGS_EQUAL(runs[Scheduler::DISPATCH_LINEAR][i], runs[mode][i]);
+        }
+    }
+};
+
+TEST(DispatchModes, SameRunsAsLinearFreeRunning)
+{
+    runEveryMode(Scheduler::RELEASE_FREE_RUNNING);
+    checkSameRunsAsLinear();
+    CHECK(runs[Scheduler::DISPATCH_LINEAR][3] > 0);
+}
+
+TEST(DispatchModes, SameRunsAsLinearSkipMissed)
+{
+    runEveryMode(Scheduler::RELEASE_SKIP_MISSED);
+    checkSameRunsAsLinear();
+}
+
+TEST(DispatchModes, SameRunsAsLinearRunOnce)
+{
+    runEveryMode(Scheduler::RELEASE_RUN_ONCE);
+    checkSameRunsAsLinear();
+}
+
+TEST(DispatchModes, SameRunsAsLinearRunAllMissed)
+{
+    runEveryMode(Scheduler::RELEASE_RUN_ALL_MISSED);
+    checkSameRunsAsLinear();
+}
+
+TEST(DispatchModes, TickWrapAround)
+{
+    /* A systick of 2^20 wraps the 32-bit counter every 4096 ticks */
+    static const uint32_t SYSTICK = 1u << 20;
+    static const uint32_t TICKS = 10000;
+    static const uint32_t PERIODS[] = { 1, 3, 7, 64 };
+    static const uint16_t NUM_PERIODS = sizeof(PERIODS) / sizeof(PERIODS[0]);
+
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        static DispatchStorage<NUM_PERIODS> storage;
+        Scheduler::Task wrap_table[NUM_PERIODS];
+        uint32_t counters[NUM_PERIODS] = { 0 };
+        Scheduler scheduler;
+
+        for( uint16_t i = 0; i < NUM_PERIODS; ++i )
+            wrap_table[i] = Scheduler::Task(countRun, &counters[i], (Scheduler::tick_t)PERIODS[i] * SYSTICK);
+
+        CHECK_TRUE(storage.use(scheduler, (Scheduler::DispatchMode)mode));
+        CHECK_TRUE(scheduler.init(wrap_table, NUM_PERIODS, SYSTICK));
+
+        for( uint32_t k = 0; k < TICKS; ++k )
+        {
+            scheduler.run();
+            scheduler.tick();
+        }
+
+        for( uint16_t i = 0; i < NUM_PERIODS; ++i )
+            LONGS_EQUAL((TICKS + PERIODS[i] - 1) / PERIODS[i], counters[i]);
+    }
+}
+
+TEST(DispatchModes, LongSleeps)
+{
+    /* Sleeps of up to a minute at 1 us, far beyond the span of the lowest wheel level */
+    static const uint32_t INTERVALS[] = { 100, 1000, 250000, 60000000 };
+    static const uint16_t NUM_INTERVALS = sizeof(INTERVALS) / sizeof(INTERVALS[0]);
+
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        static DispatchStorage<NUM_INTERVALS> storage;
+        Scheduler::Task sleep_table[NUM_INTERVALS];
+        Scheduler scheduler;
+        uint32_t random = 3;
+
+        for( uint16_t i = 0; i < NUM_INTERVALS; ++i )
+            sleep_table[i] = Scheduler::Task(countRun, &runs[mode][i], INTERVALS[i]);
+
+        CHECK_TRUE(storage.use(scheduler, (Scheduler::DispatchMode)mode));
+        CHECK_TRUE(scheduler.init(sleep_table, NUM_INTERVALS, 1));
+
+        for( uint32_t k = 0; k < 200; ++k )
+        {
+            scheduler.run();
+
+            /* Wake up on time, or late by up to a minute */
+            const uint32_t ticks = scheduler.getTicksToNextDeadline();
+            scheduler.advanceTicks((nextRandom(random) % 4 == 0) ? ticks + nextRandom(random) % 60000000 : ticks);
+        }
+    }
+
+    for( int mode = 1; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        for( uint16_t i = 0; i < NUM_INTERVALS; ++i )
+            LONGS_EQUAL(runs[Scheduler::DISPATCH_LINEAR][i], runs[mode][i]);
+    }
+    CHECK(runs[Scheduler::DISPATCH_LINEAR][NUM_INTERVALS - 1] > 1);
+}
+
+TEST_GROUP(ReleasePolicy)
+{
+    uint32_t counter;
+    Scheduler::Task table[1];
+
+    void setup()
+    {
+        counter = 0;
+        table[0] = Scheduler::Task(countRun, &counter, 10);
+    }
+
+    /* Runs at ticks 0, 10 and 20, then 45 to 60 */
+    uint32_t runWithGap(const Scheduler::ReleasePolicy policy, const Scheduler::DispatchMode mode, uint32_t& misses)
+    {
+        static DispatchStorage<1> storage;
+        Scheduler scheduler;
+
+        counter = 0;
+        CHECK_TRUE(storage.use(scheduler, mode));
+        CHECK_TRUE(scheduler.init(table, 1, 1));
+        scheduler.setReleasePolicy(policy);
+
+        for( uint32_t now = 0; now <= 60; ++now )
+        {
+            if( now == 0 || now == 10 || now == 20 || now >= 45 )
+                scheduler.run();
+            scheduler.tick();
+        }
+
+        misses = scheduler.getDeadlineMissCount();
+        return counter;
+    }
+};
+
+TEST(ReleasePolicy, CatchUpInEveryMode)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        uint32_t misses;
+        const Scheduler::DispatchMode dispatch_mode = (Scheduler::DispatchMode)mode;
+
+        /* 45, then 55 */
+        LONGS_EQUAL(5, runWithGap(Scheduler::RELEASE_FREE_RUNNING, dispatch_mode, misses));
+
+        /* The release of 40 is skipped at 45, then 50 and 60 */
+        LONGS_EQUAL(5, runWithGap(Scheduler::RELEASE_SKIP_MISSED, dispatch_mode, misses));
+        LONGS_EQUAL(1, misses);
+
+        /* 45 for the release of 40, then 50 and 60 */
+        LONGS_EQUAL(6, runWithGap(Scheduler::RELEASE_RUN_ONCE, dispatch_mode, misses));
+
+        /* 45 and 46 for the releases of 30 and 40, then 50 and 60 */
+        LONGS_EQUAL(7, runWithGap(Scheduler::RELEASE_RUN_ALL_MISSED, dispatch_mode, misses));
+    }
+}
+
+TEST(LeanScheduler, RateMonotonicPriorityOrder)
+{
+    uint16_t order[3];
+    Scheduler::Task table[] = { Scheduler::Task(logRun, &task_names[0], 30),
+                                Scheduler::Task(logRun, &task_names[1], 10),
+                                Scheduler::Task(logRun, &task_names[2], 20) };
+
+    /* The shorter the interval, the higher the priority */
+    Scheduler::assignRateMonotonicPriorities(table, 3);
+    LONGS_EQUAL(0, table[0].priority);
+    LONGS_EQUAL(2, table[1].priority);
+    LONGS_EQUAL(1, table[2].priority);
+
+    CHECK_TRUE(scheduler.usePriorityDispatch(order, 3));
+    CHECK_TRUE(scheduler.init(table, 3, 1));
+    scheduler.run();
+    STRCMP_EQUAL("BCA", run_order);
+}
+
+TEST(LeanScheduler, PriorityOrderFollowsChangedPriorities)
+{
+    uint16_t order[3];
+    Scheduler::Task table[] = { Scheduler::Task(logRun, &task_names[0], 10),
+                                Scheduler::Task(logRun, &task_names[1], 10),
+                                Scheduler::Task(logRun, &task_names[2], 10) };
+    table[0].priority = 1;
+
+    CHECK_TRUE(scheduler.usePriorityDispatch(order, 3));
+    CHECK_TRUE(scheduler.init(table, 3, 1));
+    scheduler.run();
+    STRCMP_EQUAL("ABC", run_order);
+
+    /* Picked up when the order is rebuilt */
+    table[2].priority = 2;
+    CHECK_TRUE(scheduler.usePriorityDispatch(order, 3));
+    scheduler.advanceTicks(10);
+    scheduler.run();
+    STRCMP_EQUAL("ABCCAB", run_order);
+}
+
+TEST(LeanScheduler, EdfRunsTheNearestDeadlineFirst)
+{
+    Scheduler::Task table[] = { Scheduler::Task(logRun, &task_names[0], 100),
+                                Scheduler::Task(logRun, &task_names[1], 100),
+                                Scheduler::Task(logRun, &task_names[2], 100) };
+    table[0].deadline = 20;
+    table[1].deadline = 30;
+    table[2].deadline = 10;
+
+    scheduler.useEdfDispatch();
+    CHECK_TRUE(scheduler.init(table, 3, 1));
+    scheduler.run();
+    STRCMP_EQUAL("CAB", run_order);
+}
+
+TEST(LeanScheduler, EdfDeadlineDefaultsToTheInterval)
+{
+    Scheduler::Task table[] = { Scheduler::Task(logRun, &task_names[0], 30),
+                                Scheduler::Task(logRun, &task_names[1], 10),
+                                Scheduler::Task(logRun, &task_names[2], 20) };
+
+    scheduler.useEdfDispatch();
+    CHECK_TRUE(scheduler.init(table, 3, 1));
+    scheduler.run();
+    STRCMP_EQUAL("BCA", run_order);
+}
+
+TEST(LeanScheduler, BitmapIgnoresWordsPastTheTable)
+{
+    static Scheduler::ReadyBitmap<256> bitmap;
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 10), Scheduler::Task(plainTask, 5) };
+
+    CHECK_TRUE(scheduler.init(table, 2, 1));
+    CHECK_TRUE(scheduler.useBitmapDispatch(bitmap));
+
+    /* Storage past the bound table is never read */
+    bitmap.released[7] = 0xFFFFFFFF;
+
+    for( int i = 0; i < 20; ++i )
+    {
+        scheduler.run();
+        scheduler.tick();
+    }
+    LONGS_EQUAL(6, plain_runs);
+}
+
+static Scheduler* busy_scheduler = NULL;
+
+/* Task function that runs for 6 system ticks */
+static void busyTask(void)
+{
+    for( int i = 0; i < 6; ++i )
+        busy_scheduler->tick();
+}
+
+static Scheduler::Task* faulty_task = NULL;
+static Scheduler::TimingFault last_fault = Scheduler::FAULT_DEADLINE_MISS;
+static uint32_t num_faults = 0;
+
+/* Fault handler that sheds load by stretching the interval of the faulty task */
+static void stretchOnFault(Scheduler::Task& task, Scheduler::TimingFault fault)
+{
+    faulty_task = &task;
+    last_fault = fault;
+    ++num_faults;
+    task.interval = 100;
+}
+
+TEST(LeanScheduler, DeadlineMissReachesTheFaultHandler)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 100), Scheduler::Task(busyTask, 5) };
+    busy_scheduler = &scheduler;
+    num_faults = 0;
+
+    CHECK_TRUE(scheduler.init(table, 2, 1));
+    scheduler.setTimingFaultHandler(stretchOnFault);
+    scheduler.run();
+
+    LONGS_EQUAL(1, num_faults);
+    POINTERS_EQUAL(&table[1], faulty_task);
+    LONGS_EQUAL(Scheduler::FAULT_DEADLINE_MISS, last_fault);
+    LONGS_EQUAL(1, scheduler.getDeadlineMissCount());
+
+    /* The stretched interval leaves room for the task */
+    scheduler.advanceTicks(100);
+    scheduler.run();
+    LONGS_EQUAL(1, num_faults);
+    LONGS_EQUAL(1, scheduler.getDeadlineMissCount());
+}
+
+TEST(LeanScheduler, BudgetOverrunReachesTheFaultHandler)
+{
+    Scheduler::Task table[] = { Scheduler::Task(busyTask, 100) };
+    table[0].budget = 4;
+    busy_scheduler = &scheduler;
+    num_faults = 0;
+
+    CHECK_TRUE(scheduler.init(table, 1, 1));
+    scheduler.setTimingFaultHandler(stretchOnFault);
+    scheduler.run();
+
+    LONGS_EQUAL(1, num_faults);
+    POINTERS_EQUAL(&table[0], faulty_task);
+    LONGS_EQUAL(Scheduler::FAULT_BUDGET_OVERRUN, last_fault);
+    LONGS_EQUAL(1, scheduler.getBudgetOverrunCount());
+    LONGS_EQUAL(0, scheduler.getDeadlineMissCount());
+}
+
+TEST(LeanScheduler, EventBudgetsStartWithEachEvent)
+{
+    static Scheduler::EventQueue<4> queue;
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 1000) };
+    Scheduler::Task events[] = { Scheduler::Task(busyTask, 0), Scheduler::Task(busyTask, 0) };
+    events[0].budget = 10;
+    events[1].budget = 10;
+    busy_scheduler = &scheduler;
+
+    CHECK_TRUE(scheduler.init(table, 1, 1));
+    CHECK_TRUE(scheduler.useEventQueue(events, 2, queue));
+    CHECK_TRUE(scheduler.post(0));
+    CHECK_TRUE(scheduler.post(1));
+
+    scheduler.run();
+    LONGS_EQUAL(0, scheduler.getBudgetOverrunCount());
+
+    /* A single event over its budget is still caught */
+    events[1].budget = 5;
+    CHECK_TRUE(scheduler.post(1));
+    scheduler.run();
+    LONGS_EQUAL(1, scheduler.getBudgetOverrunCount());
+}
+
+TEST(LeanScheduler, BackgroundBudgetsStartWithEachTask)
+{
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 1000) };
+    Scheduler::Task background[] = { Scheduler::Task(busyTask, 0), Scheduler::Task(busyTask, 0) };
+    background[0].budget = 10;
+    background[1].budget = 10;
+    busy_scheduler = &scheduler;
+
+    CHECK_TRUE(scheduler.init(table, 1, 1));
+    CHECK_TRUE(scheduler.useBackgroundTasks(background, 2));
+
+    /* The first pass runs the table, the second one is idle */
+    scheduler.run();
+    scheduler.run();
+    LONGS_EQUAL(0, scheduler.getBudgetOverrunCount());
+    LONGS_EQUAL(12, scheduler.getIdleTicks());
+}
+
+static bool idle_before_post = false;
+static bool idle_after_post = false;
+
+/* Sleep handler interrupted by a post() before it checks again */
+static void postBeforeSleep(uint32_t ticks)
+{
+    (void)ticks;
+    idle_before_post = busy_scheduler->isIdle();
+    busy_scheduler->post(0);
+    idle_after_post = busy_scheduler->isIdle();
+}
+
+TEST(LeanScheduler, IsIdleSeesEventsPostedBeforeSleep)
+{
+    static Scheduler::EventQueue<4> queue;
+    Scheduler::Task table[] = { Scheduler::Task(plainTask, 1000) };
+    Scheduler::Task events[] = { Scheduler::Task(plainTask, 0) };
+    busy_scheduler = &scheduler;
+
+    CHECK_TRUE(scheduler.init(table, 1, 1));
+    CHECK_TRUE(scheduler.useEventQueue(events, 1, queue));
+    CHECK_FALSE(scheduler.isIdle());
+
+    scheduler.run();
+    CHECK_TRUE(scheduler.isIdle());
+
+    scheduler.setSleepHandler(postBeforeSleep);
+    scheduler.run();
+    CHECK_TRUE(idle_before_post);
+    CHECK_FALSE(idle_after_post);
+
+    scheduler.run();
+    LONGS_EQUAL(2, plain_runs);
+    CHECK_TRUE(scheduler.isIdle());
+}
@@ -0,0 +1,132 @@
+/**
+ * @file test_StaticScheduler.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Tests of the compile-time task table of StaticScheduler.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "StaticScheduler.hpp"
+#include "Scheduler.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+static uint32_t slow_runs = 0;
+static uint32_t fast_runs = 0;
+static uint32_t continuous_runs = 0;
+static char call_order[8];
+static uint8_t num_calls = 0;
+
+static void slowTask(void)
+{
+    ++slow_runs;
+    if( num_calls < sizeof(call_order) )
+        call_order[num_calls++] = 'S';
+}
+
+static void fastTask(void)
+{
+    ++fast_runs;
+    if( num_calls < sizeof(call_order) )
+        call_order[num_calls++] = 'F';
+}
+
+static void continuousTask(void)
+{
+    ++continuous_runs;
+}
+
+/* Task function of the equivalent Scheduler table, counting in its context */
+static void countDynamic(void* context)
+{
+    ++*static_cast<uint32_t*>(context);
+}
+
+typedef StaticScheduler< StaticTask<slowTask, 10>, StaticTask<fastTask, 3>, StaticTask<continuousTask, 0> > TestScheduler;
+
+TEST_GROUP(StaticScheduler)
+{
+    TestScheduler scheduler;
+
+    void setup()
+    {
+        slow_runs = 0;
+        fast_runs = 0;
+        continuous_runs = 0;
+        num_calls = 0;
+    }
+};
+
+TEST(StaticScheduler, EveryTaskRunsOnFirstRunInListedOrder)
+{
+    LONGS_EQUAL(3, TestScheduler::num_tasks);
+
+    scheduler.run();
+    LONGS_EQUAL(2, num_calls);
+    LONGS_EQUAL('S', call_order[0]);
+    LONGS_EQUAL('F', call_order[1]);
+    LONGS_EQUAL(1, continuous_runs);
+}
+
+TEST(StaticScheduler, SameRunsAsScheduler)
+{
+    uint32_t dynamic_runs[2] = { 0, 0 };
+    Scheduler::Task table[] = { Scheduler::Task(countDynamic, &dynamic_runs[0], 10),
+                                Scheduler::Task(countDynamic, &dynamic_runs[1], 3) };
+    Scheduler dynamic;
+    CHECK_TRUE(dynamic.init(table, 2, 1));
+
+    for( int i = 0; i < 100; ++i )
+    {
+        scheduler.run();
+        dynamic.run();
+        scheduler.tick();
+        dynamic.tick();
+    }
+
+    LONGS_EQUAL(dynamic_runs[0], slow_runs);
+    LONGS_EQUAL(dynamic_runs[1], fast_runs);
+    LONGS_EQUAL(10, slow_runs);
+    LONGS_EQUAL(100, continuous_runs);
+}
+
+TEST(StaticScheduler, TickWrapAround)
+{
+    scheduler.run();
+    scheduler.sys_tick_ctr_ = UINT32_MAX - 4;
+    scheduler.run();
+    LONGS_EQUAL(2, slow_runs);
+
+    for( int i = 0; i < 9; ++i )
+    {
+        scheduler.tick();
+        scheduler.run();
+    }
+    LONGS_EQUAL(2, slow_runs);
+
+    scheduler.tick();
+    scheduler.run();
+    LONGS_EQUAL(3, slow_runs);
+    LONGS_EQUAL(5, scheduler.getTickCount());
+}
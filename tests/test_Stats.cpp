@@ -0,0 +1,122 @@
+/**
+ * @file test_Stats.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Tests of the per-task runtime and release jitter statistics.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Scheduler.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+#ifdef SCHEDULER_ENABLE_STATS
+
+static Scheduler* stats_scheduler = NULL;
+static uint32_t stats_cycles = 0;
+static uint32_t next_runtime = 0;
+static uint32_t next_ticks = 0;
+
+static uint32_t readStatsCycles(void)
+{
+    return stats_cycles;
+}
+
+/* Task function that takes [next_runtime] cycles and [next_ticks] system ticks */
+static void timedTask(void)
+{
+    stats_cycles += next_runtime;
+    for( uint32_t i = 0; i < next_ticks; ++i )
+        stats_scheduler->tick();
+}
+
+TEST_GROUP(Stats)
+{
+    Scheduler scheduler;
+    Scheduler::Task table[1];
+
+    void setup()
+    {
+        stats_scheduler = &scheduler;
+        stats_cycles = 0;
+        next_runtime = 0;
+        next_ticks = 0;
+
+        table[0] = Scheduler::Task(timedTask, 10);
+        CHECK_TRUE(scheduler.init(table, 1, 1));
+        scheduler.setCycleCounter(readStatsCycles);
+    }
+};
+
+TEST(Stats, RuntimesOfEveryRun)
+{
+    next_runtime = 100;
+    scheduler.run();
+    scheduler.advanceTicks(10);
+    next_runtime = 300;
+    scheduler.run();
+
+    const Scheduler::TaskStats& stats = table[0].stats;
+    LONGS_EQUAL(2, stats.run_count);
+    LONGS_EQUAL(100, stats.min_runtime);
+    LONGS_EQUAL(300, stats.max_runtime);
+    LONGS_EQUAL(200, stats.getAverageRuntime());
+}
+
+TEST(Stats, LargestReleaseJitter)
+{
+    scheduler.run();
+    scheduler.advanceTicks(13);
+    scheduler.run();
+    scheduler.advanceTicks(11);
+    scheduler.run();
+
+    LONGS_EQUAL(3, table[0].stats.max_jitter);
+}
+
+TEST(Stats, RunOfAWholeIntervalIsAnOverrun)
+{
+    scheduler.run();
+    scheduler.advanceTicks(10);
+    next_ticks = 10;
+    scheduler.run();
+
+    LONGS_EQUAL(2, table[0].stats.run_count);
+    LONGS_EQUAL(1, table[0].stats.overrun_count);
+}
+
+TEST(Stats, ResetClearsEveryTask)
+{
+    next_runtime = 100;
+    scheduler.run();
+    scheduler.resetStats();
+
+    const Scheduler::TaskStats& stats = table[0].stats;
+    LONGS_EQUAL(0, stats.run_count);
+    LONGS_EQUAL(UINT32_MAX, stats.min_runtime);
+    LONGS_EQUAL(0, stats.max_runtime);
+    LONGS_EQUAL(0, stats.getAverageRuntime());
+}
+
+#endif
@@ -0,0 +1,337 @@
+/**
+ * @file test_TaskPool.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Tests of the task pool and software timers in every dispatch mode.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "DispatchModes.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+static const uint16_t POOL_SIZE = 4;
+
+TEST_GROUP(TaskPool)
+{
+    DispatchStorage<POOL_SIZE> storage;
+    Scheduler::Task table[POOL_SIZE];
+    uint32_t counters[POOL_SIZE];
+    Scheduler scheduler;
+
+    /* One periodic task of interval 10, the other slots free */
+    void start(const int mode)
+    {
+        for( uint16_t i = 0; i < POOL_SIZE; ++i )
+        {
+            table[i] = Scheduler::Task();
+            counters[i] = 0;
+        }
+        table[0] = Scheduler::Task(countRun, &counters[0], 10);
+
+        scheduler = Scheduler();
+        CHECK_TRUE(storage.use(scheduler, (Scheduler::DispatchMode)mode));
+        CHECK_TRUE(scheduler.init(table, POOL_SIZE, 1));
+    }
+
+    void runTicks(const uint32_t num_ticks)
+    {
+        for( uint32_t k = 0; k < num_ticks; ++k )
+        {
+            scheduler.run();
+            scheduler.tick();
+        }
+    }
+};
+
+TEST(TaskPool, AddedTaskRunsEveryInterval)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        start(mode);
+
+        POINTERS_EQUAL(&table[1], scheduler.addTask(Scheduler::Task(countRun, &counters[1], 5)));
+        runTicks(20);
+        LONGS_EQUAL(4, counters[1]);
+        LONGS_EQUAL(2, counters[0]);
+    }
+}
+
+TEST(TaskPool, FullPoolRejectsTasks)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        start(mode);
+
+        for( uint16_t i = 1; i < POOL_SIZE; ++i )
+            POINTERS_EQUAL(&table[i], scheduler.addTask(Scheduler::Task(countRun, &counters[i], 10)));
+
+        POINTERS_EQUAL(NULL, scheduler.addTask(Scheduler::Task(countRun, &counters[0], 10)));
+        POINTERS_EQUAL(NULL, scheduler.startTimer(countRun, &counters[0], 10));
+    }
+}
+
+TEST(TaskPool, AddRejectsContinuousTasks)
+{
+    start(Scheduler::DISPATCH_LINEAR);
+
+    POINTERS_EQUAL(NULL, scheduler.addTask(Scheduler::Task(countRun, &counters[1], 0)));
+}
+
+TEST(TaskPool, RemovedTaskStopsAndItsSlotIsReused)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        start(mode);
+        runTicks(5);
+
+        CHECK_TRUE(scheduler.removeTask(table[0]));
+        CHECK_FALSE(scheduler.removeTask(table[0]));
+
+        /* Past the last queued release of the removed task */
+        runTicks(20);
+        LONGS_EQUAL(1, counters[0]);
+
+        POINTERS_EQUAL(&table[0], scheduler.addTask(Scheduler::Task(countRun, &counters[1], 10)));
+        runTicks(2);
+        LONGS_EQUAL(1, counters[1]);
+    }
+}
+
+TEST(TaskPool, DisabledTaskRunsOneIntervalAfterEnable)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        start(mode);
+        runTicks(1);
+
+        scheduler.disableTask(table[0]);
+        CHECK_FALSE(table[0].isActive());
+        runTicks(50);
+        LONGS_EQUAL(1, counters[0]);
+
+        scheduler.enableTask(table[0]);
+        runTicks(10);
+        LONGS_EQUAL(1, counters[0]);
+        runTicks(1);
+        LONGS_EQUAL(2, counters[0]);
+    }
+}
+
+TEST(TaskPool, ResumedTaskKeepsItsReleaseGrid)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        start(mode);
+        runTicks(1);
+
+        scheduler.suspendTask(table[0]);
+        runTicks(34);
+        LONGS_EQUAL(1, counters[0]);
+
+        /* Resumed at 35, the next release on the grid is 40 */
+        scheduler.resumeTask(table[0]);
+        runTicks(5);
+        LONGS_EQUAL(1, counters[0]);
+        runTicks(1);
+        LONGS_EQUAL(2, counters[0]);
+    }
+}
+
+TEST(TaskPool, TimerRunsOnceAfterItsDelay)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        start(mode);
+        runTicks(1);
+
+        Scheduler::Task* const timer = scheduler.startTimer(countRun, &counters[1], 7);
+        POINTERS_EQUAL(&table[1], timer);
+
+        runTicks(7);
+        LONGS_EQUAL(0, counters[1]);
+        runTicks(1);
+        LONGS_EQUAL(1, counters[1]);
+
+        runTicks(50);
+        LONGS_EQUAL(1, counters[1]);
+        CHECK_FALSE(scheduler.cancelTimer(*timer));
+    }
+}
+
+TEST(TaskPool, CancelledTimerDoesNotRun)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        start(mode);
+
+        Scheduler::Task* const timer = scheduler.startTimer(countRun, &counters[1], 7);
+        CHECK(timer != NULL);
+        CHECK_TRUE(scheduler.cancelTimer(*timer));
+        CHECK_FALSE(scheduler.cancelTimer(*timer));
+        CHECK_FALSE(scheduler.cancelTimer(table[0]));
+
+        runTicks(50);
+        LONGS_EQUAL(0, counters[1]);
+    }
+}
+
+TEST(TaskPool, TimerSlotsAreReused)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        start(mode);
+
+        /* Many more timers than free slots, one at a time */
+        for( uint32_t k = 0; k < 20; ++k )
+        {
+            CHECK(scheduler.startTimer(countRun, &counters[1], 3) != NULL);
+            runTicks(10);
+        }
+        LONGS_EQUAL(20, counters[1]);
+    }
+}
+
+TEST(TaskPool, RemovedContinuousTaskLeavesTheHeap)
+{
+    Scheduler::DispatchEntry queue[3];
+    Scheduler::Task pool[] = { Scheduler::Task(countRun, &counters[0], 0), Scheduler::Task(countRun, &counters[1], 10) };
+    counters[0] = counters[1] = counters[2] = 0;
+
+    /* Past the end of the storage */
+    queue[2].task = 0x5A5A;
+
+    CHECK_TRUE(scheduler.init(pool, 2, 1));
+    CHECK_TRUE(scheduler.useHeapDispatch(queue, 2));
+    CHECK_TRUE(scheduler.removeTask(pool[0]));
+
+    /* Reused once the dispatcher dropped its entry */
+    runTicks(1);
+    POINTERS_EQUAL(&pool[0], scheduler.addTask(Scheduler::Task(countRun, &counters[2], 1000)));
+    runTicks(100);
+
+    LONGS_EQUAL(0x5A5A, queue[2].task);
+    LONGS_EQUAL(0, counters[0]);
+    LONGS_EQUAL(11, counters[1]);
+    LONGS_EQUAL(1, counters[2]);
+}
+
+TEST(TaskPool, RemovedContinuousTaskSlotIsReused)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        start(mode);
+        table[0] = Scheduler::Task(countRun, &counters[0], 0);
+        CHECK_TRUE(scheduler.init(table, POOL_SIZE, 1));
+        runTicks(3);
+
+        CHECK_TRUE(scheduler.removeTask(table[0]));
+        runTicks(3);
+        LONGS_EQUAL(3, counters[0]);
+
+        for( uint16_t i = 0; i < POOL_SIZE; ++i )
+            CHECK(scheduler.addTask(Scheduler::Task(countRun, &counters[1], 1000)) != NULL);
+        POINTERS_EQUAL(NULL, scheduler.addTask(Scheduler::Task(countRun, &counters[1], 1000)));
+
+        runTicks(100);
+        LONGS_EQUAL(POOL_SIZE, counters[1]);
+    }
+}
+
+TEST(TaskPool, FiredOrCancelledTimerFreesItsSlotAtOnce)
+{
+    for( int mode = 0; mode < NUM_DISPATCH_MODES; ++mode )
+    {
+        start(mode);
+
+        /* Leave a single free slot */
+        CHECK(scheduler.addTask(Scheduler::Task(countRun, &counters[2], 10)) != NULL);
+        CHECK(scheduler.addTask(Scheduler::Task(countRun, &counters[3], 10)) != NULL);
+
+        Scheduler::Task* timer = scheduler.startTimer(countRun, &counters[1], 5000);
+        CHECK(timer != NULL);
+        runTicks(5001);
+        LONGS_EQUAL(1, counters[1]);
+
+        timer = scheduler.startTimer(countRun, &counters[1], 5000);
+        CHECK(timer != NULL);
+        CHECK_TRUE(scheduler.cancelTimer(*timer));
+
+        timer = scheduler.startTimer(countRun, &counters[1], 3);
+        CHECK(timer != NULL);
+        runTicks(4);
+        LONGS_EQUAL(2, counters[1]);
+    }
+}
+
+static uint8_t run_order[POOL_SIZE];
+static uint8_t num_run = 0;
+
+static void recordRun(void* context)
+{
+    run_order[num_run++] = (uint8_t)(uintptr_t)context;
+}
+
+TEST(TaskPool, AddedTaskTakesItsPlaceInPriorityOrder)
+{
+    start(Scheduler::DISPATCH_PRIORITY);
+    table[0] = Scheduler::Task(recordRun, (void*)0, 10);
+    table[0].priority = 1;
+    CHECK_TRUE(scheduler.init(table, POOL_SIZE, 1));
+
+    Scheduler::Task task(recordRun, (void*)1, 10);
+    task.priority = 0;
+    CHECK(scheduler.addTask(task) != NULL);
+    task = Scheduler::Task(recordRun, (void*)2, 10);
+    task.priority = 2;
+    CHECK(scheduler.addTask(task) != NULL);
+    task = Scheduler::Task(recordRun, (void*)3, 10);
+    task.priority = 1;
+    CHECK(scheduler.addTask(task) != NULL);
+
+    num_run = 0;
+    scheduler.run();
+    LONGS_EQUAL(4, num_run);
+    LONGS_EQUAL(2, run_order[0]);
+    LONGS_EQUAL(0, run_order[1]);
+    LONGS_EQUAL(3, run_order[2]);
+    LONGS_EQUAL(1, run_order[3]);
+
+    /* A slot reused with another priority moves */
+    CHECK_TRUE(scheduler.removeTask(table[1]));
+    task = Scheduler::Task(recordRun, (void*)1, 10);
+    task.priority = 3;
+    POINTERS_EQUAL(&table[1], scheduler.addTask(task));
+
+    for( uint32_t k = 0; k < 10; ++k )
+        scheduler.tick();
+
+    num_run = 0;
+    scheduler.run();
+    LONGS_EQUAL(4, num_run);
+    LONGS_EQUAL(1, run_order[0]);
+    LONGS_EQUAL(2, run_order[1]);
+    LONGS_EQUAL(0, run_order[2]);
+    LONGS_EQUAL(3, run_order[3]);
+}
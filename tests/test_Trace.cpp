@@ -0,0 +1,109 @@
+/**
+ * @file test_Trace.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Tests of the trace ring buffer, written from tasks and from tick().
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Scheduler.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+#ifdef SCHEDULER_ENABLE_TRACE
+
+static Scheduler* trace_scheduler = NULL;
+static uint32_t trace_clock = 0;
+static int32_t interrupt_in = -1;
+static bool in_interrupt = false;
+static uint32_t interrupts = 0;
+
+/* Tick interrupt, which does not nest in itself */
+static void tickInterrupt(void)
+{
+    in_interrupt = true;
+    ++interrupts;
+    trace_scheduler->tick();
+    in_interrupt = false;
+}
+
+/*  Cycle counter that takes a tick interrupt just before the read number
+*   [interrupt_in], so that the interrupt lands at every point of a pass.
+*/
+static uint32_t readTraceClock(void)
+{
+    if( !in_interrupt && interrupt_in >= 0 && interrupt_in-- == 0 )
+        tickInterrupt();
+    return ++trace_clock;
+}
+
+static void traceTask(void)
+{
+}
+
+TEST_GROUP(Trace)
+{
+    Scheduler scheduler;
+
+    void setup()
+    {
+        trace_scheduler = &scheduler;
+        trace_clock = 0;
+        interrupt_in = -1;
+        interrupts = 0;
+    }
+};
+
+TEST(Trace, SlotsAreInTimestampOrder)
+{
+    static Scheduler::TraceBuffer<256> buffer;
+    static Scheduler::TraceEvent events[256];
+    Scheduler::Task table[] = { Scheduler::Task(traceTask, 1), Scheduler::Task(traceTask, 2) };
+    CHECK_TRUE(scheduler.init(table, 2, 1));
+    scheduler.setCycleCounter(readTraceClock);
+    scheduler.useTraceBuffer(buffer);
+
+    for( int32_t delay = 0; delay < 16; ++delay )
+    {
+        interrupt_in = delay;
+        scheduler.run();
+        tickInterrupt();
+    }
+
+    /* Nothing was overwritten */
+    const uint32_t count = scheduler.copyTrace(events, 256);
+    LONGS_EQUAL(scheduler.getTraceCount(), count);
+
+    uint32_t ticks = 0;
+    for( uint32_t i = 0; i < count; ++i )
+    {
+        if( i > 0 )
+            CHECK(events[i].timestamp > events[i - 1].timestamp);
+        if( events[i].type == Scheduler::TRACE_TICK )
+            ++ticks;
+    }
+    LONGS_EQUAL(interrupts, ticks);
+}
+
+#endif
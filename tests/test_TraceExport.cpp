@@ -0,0 +1,110 @@
+/**
+ * @file test_TraceExport.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Tests of the conversion of trace records to Chrome trace JSON.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Scheduler.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+#ifdef SCHEDULER_ENABLE_TRACE
+
+#include "TraceExporter.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+TEST_GROUP(TraceExport)
+{
+    FILE* out;
+    char json[4096];
+
+    void setup()
+    {
+        out = std::tmpfile();
+        CHECK(out != NULL);
+    }
+
+    void teardown()
+    {
+        std::fclose(out);
+    }
+
+    /* Export tick events at [timestamps], one count per microsecond */
+    void exportTicks(const uint32_t* const timestamps, const int count)
+    {
+        TraceExporter exporter(out, 1.0);
+        exporter.begin();
+        for( int i = 0; i < count; ++i )
+        {
+            const uint8_t record[8] = { (uint8_t)timestamps[i], (uint8_t)(timestamps[i] >> 8),
+                                        (uint8_t)(timestamps[i] >> 16), (uint8_t)(timestamps[i] >> 24),
+                                        0, 0, Scheduler::TRACE_TICK, Scheduler::TRACE_TASK_TABLE };
+            exporter.event(record);
+        }
+        exporter.finish();
+
+        std::rewind(out);
+        const size_t length = std::fread(json, 1, sizeof(json) - 1, out);
+        json[length] = '\0';
+    }
+
+    /* The "ts" of the exported events, in order */
+    void checkTimes(const double* const expected, const int count)
+    {
+        const char* cursor = json;
+        for( int i = 0; i < count; ++i )
+        {
+            cursor = std::strstr(cursor, "\"ts\":");
+            CHECK(cursor != NULL);
+            cursor += 5;
+            DOUBLES_EQUAL(expected[i], std::strtod(cursor, NULL), 0.001);
+        }
+        CHECK(std::strstr(cursor, "\"ts\":") == NULL);
+    }
+};
+
+TEST(TraceExport, CounterWrapIsUnwrapped)
+{
+    const uint32_t timestamps[] = { 0xFFFFFF00u, 0xFFFFFFF0u, 0x00000010u, 0x00000100u };
+    const double expected[] = { 0.0, 240.0, 272.0, 512.0 };
+
+    exportTicks(timestamps, 4);
+    checkTimes(expected, 4);
+}
+
+TEST(TraceExport, StepBackCountsAsNoTime)
+{
+    /* A tick recorded after the event it interrupted */
+    const uint32_t timestamps[] = { 1000, 2000, 1990, 2100 };
+    const double expected[] = { 0.0, 1000.0, 1000.0, 1100.0 };
+
+    exportTicks(timestamps, 4);
+    checkTimes(expected, 4);
+}
+
+#endif
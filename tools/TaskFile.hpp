@@ -0,0 +1,187 @@
+/**
+ * @file TaskFile.hpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Task table description shared by the host tools.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/*  Task file, one task per line, '#' starts a comment. Times are in microseconds:
+*
+*       <name> <interval> fixed <time>              [key=value ...]
+*       <name> <interval> uniform <min> <max>       [key=value ...]
+*       <name> <interval> normal <mean> <stddev>    [key=value ...]
+*       <name> <interval> trace <file>              [key=value ...]
+*
+*   A trace file lists measured execution times, one per line.
+*   Keys: priority, deadline, budget, phase, and wcet for the schedulability analysis.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+enum ExecModel {
+    EXEC_FIXED,     /*!< Always the same time */
+    EXEC_UNIFORM,   /*!< Uniform between two times */
+    EXEC_NORMAL,    /*!< Normal distribution, clamped at 0 */
+    EXEC_TRACE      /*!< Replays measured times */
+};
+
+/**
+ * @brief A single line of a task file
+ *
+ */
+struct TaskSpec {
+    std::string name;
+    uint64_t interval = 0;          /*!< Interval in microseconds */
+    ExecModel model = EXEC_FIXED;
+    double a = 0.0;                 /*!< Fixed time, minimum or mean, in microseconds */
+    double b = 0.0;                 /*!< Maximum or standard deviation, in microseconds */
+    std::vector<double> samples;    /*!< Times of EXEC_TRACE */
+    uint8_t priority = 0;           /*!< Task::priority */
+    uint64_t deadline = 0;          /*!< Task::deadline, 0 for the interval */
+    uint64_t budget = 0;            /*!< Task::budget, 0 for no limit */
+    uint64_t phase = 0;             /*!< Task::phase, less than the interval */
+    double wcet = 0.0;              /*!< Worst-case execution time, 0 to derive it from the model */
+
+    /**
+     * @brief Get the worst-case execution time
+     *
+     * @param wcet_us Worst-case execution time in microseconds
+     * @return true     When known: given, or bounded by the model
+     * @return false    For a normal model without a wcet key
+     */
+    bool getWcet(double& wcet_us) const {
+        if( wcet > 0.0 )
+            wcet_us = wcet;
+        else if( model == EXEC_FIXED )
+            wcet_us = a;
+        else if( model == EXEC_UNIFORM )
+            wcet_us = b;
+        else if( model == EXEC_TRACE )
+            wcet_us = *std::max_element(samples.begin(), samples.end());
+        else
+            return false;
+        return true;
+    }
+};
+
+static bool loadSamples(const std::string& path, std::vector<double>& samples)
+{
+    std::ifstream file(path.c_str());
+    double us;
+    while( file >> us )
+        samples.push_back(us);
+    return !samples.empty();
+}
+
+/**
+ * @brief Parse a task file, reporting the first invalid line on stderr
+ *
+ * @param path  Task file
+ * @param tasks Parsed tasks, in file order
+ * @return true     When the file holds at least one task and no invalid line
+ */
+static bool loadTaskFile(const char* const path, std::vector<TaskSpec>& tasks)
+{
+    std::ifstream file(path);
+    if( !file )
+    {
+        std::fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    std::string line;
+    unsigned line_number = 0;
+    while( std::getline(file, line) )
+    {
+        ++line_number;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream fields(line);
+        TaskSpec task;
+        std::string model;
+        if( !(fields >> task.name) )
+            continue;
+
+        bool valid = (bool)(fields >> task.interval >> model);
+        if( valid && model == "fixed" )
+            valid = (bool)(fields >> task.a);
+        else if( valid && (model == "uniform" || model == "normal") )
+        {
+            task.model = (model == "uniform") ? EXEC_UNIFORM : EXEC_NORMAL;
+            valid = (bool)(fields >> task.a >> task.b);
+        }
+        else if( valid && model == "trace" )
+        {
+            std::string samples;
+            task.model = EXEC_TRACE;
+            valid = (fields >> samples) && loadSamples(samples, task.samples);
+        }
+        else
+            valid = false;
+
+        std::string option;
+        while( valid && fields >> option )
+        {
+            const size_t equals = option.find('=');
+            const std::string key = option.substr(0, equals);
+            const char* const value = option.c_str() + equals + 1;
+
+            if( equals == std::string::npos )
+                valid = false;
+            else if( key == "priority" )
+                task.priority = (uint8_t)std::strtoul(value, NULL, 10);
+            else if( key == "deadline" )
+                task.deadline = std::strtoull(value, NULL, 10);
+            else if( key == "budget" )
+                task.budget = std::strtoull(value, NULL, 10);
+            else if( key == "phase" )
+                task.phase = std::strtoull(value, NULL, 10);
+            else if( key == "wcet" )
+                task.wcet = std::strtod(value, NULL);
+            else
+                valid = false;
+        }
+
+        if( !valid )
+        {
+            std::fprintf(stderr, "%s:%u: invalid task\n", path, line_number);
+            return false;
+        }
+
+        tasks.push_back(task);
+    }
+
+    return !tasks.empty();
+}
@@ -0,0 +1,158 @@
+/**
+ * @file TraceExporter.hpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Conversion of binary scheduler trace records to Chrome trace JSON.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/*  Streams the records written by Scheduler::copyTrace(), stored as raw little-endian
+*   TraceEvent structs, as Chrome trace JSON. Include it with SCHEDULER_ENABLE_TRACE
+*   defined, for Scheduler::TraceEvent.
+*/
+
+#pragma once
+
+#include "Scheduler.hpp"
+
+#include <cstdio>
+
+typedef Scheduler::TraceEvent TraceEvent;
+
+/* Thread of the task events, tick events go to a thread of their own */
+static const int TASK_TID = 0;
+static const int TICK_TID = 1;
+
+static const char* const SOURCE_NAMES[] = { "task", "event", "background" };
+
+/* Converts the trace, one event at a time */
+class TraceExporter {
+    public:
+        TraceExporter(FILE* const out, const double us_per_count) :
+            out_(out), us_per_count_(us_per_count) {}
+
+        void begin(void) {
+            std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", out_);
+            metadata(TASK_TID, "run()");
+            metadata(TICK_TID, "tick()");
+        }
+
+        void event(const uint8_t* const record) {
+            TraceEvent event;
+            event.timestamp = (uint32_t)record[0] | ((uint32_t)record[1] << 8) |
+                              ((uint32_t)record[2] << 16) | ((uint32_t)record[3] << 24);
+            event.task = (uint16_t)(record[4] | (record[5] << 8));
+            event.type = record[6];
+            event.source = record[7];
+
+            /*  Unwrap the 32-bit counter, the trace has at least one event per half wrap.
+            *   A step back, e.g. a tick recorded after an event it interrupted, counts as no time.
+            */
+            const int32_t delta = started_ ? (int32_t)(event.timestamp - last_timestamp_) : 0;
+            if( !started_ || delta > 0 )
+                last_timestamp_ = event.timestamp;
+            if( delta > 0 )
+                time_ += (uint32_t)delta;
+            started_ = true;
+
+            const double ts = (double)time_ * us_per_count_;
+            const char* const source = (event.source < 3) ? SOURCE_NAMES[event.source] : "unknown";
+
+            switch( event.type )
+            {
+                case Scheduler::TRACE_TASK_START:
+                    /* Tasks do not nest, close a start whose end was lost */
+                    if( open_ )
+                        end(ts);
+                    separator();
+                    std::fprintf(out_, "{\"name\":\"%s %u\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":0,\"tid\":%d}",
+                                 source, (unsigned)event.task, ts, TASK_TID);
+                    open_ = true;
+                    break;
+                case Scheduler::TRACE_TASK_END:
+                    /* The oldest events of a ring may end a task whose start was overwritten */
+                    if( open_ )
+                        end(ts);
+                    break;
+                case Scheduler::TRACE_TICK:
+                    instant("tick", ts, TICK_TID);
+                    break;
+                case Scheduler::TRACE_DEADLINE_MISS:
+                    separator();
+                    std::fprintf(out_, "{\"name\":\"deadline miss %s %u\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":0,\"tid\":%d}",
+                                 source, (unsigned)event.task, ts, TASK_TID);
+                    break;
+                case Scheduler::TRACE_BUDGET_OVERRUN:
+                    separator();
+                    std::fprintf(out_, "{\"name\":\"budget overrun %s %u\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":0,\"tid\":%d}",
+                                 source, (unsigned)event.task, ts, TASK_TID);
+                    break;
+                default:
+                    ++unknown_;
+                    break;
+            }
+        }
+
+        void finish(void) {
+            if( open_ )
+                end((double)time_ * us_per_count_);
+            std::fputs("\n]}\n", out_);
+        }
+
+        unsigned long getUnknownCount(void) const {
+            return unknown_;
+        }
+
+    private:
+        FILE* out_;
+        double us_per_count_;
+        uint64_t time_ = 0;
+        uint32_t last_timestamp_ = 0;
+        bool started_ = false;
+        bool open_ = false;
+        bool first_ = true;
+        unsigned long unknown_ = 0;
+
+        void separator(void) {
+            if( !first_ )
+                std::fputs(",\n", out_);
+            first_ = false;
+        }
+
+        void end(const double ts) {
+            separator();
+            std::fprintf(out_, "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":0,\"tid\":%d}", ts, TASK_TID);
+            open_ = false;
+        }
+
+        void instant(const char* const name, const double ts, const int tid) {
+            separator();
+            std::fprintf(out_, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":0,\"tid\":%d}", name, ts, tid);
+        }
+
+        void metadata(const int tid, const char* const name) {
+            separator();
+            std::fprintf(out_, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", tid, name);
+        }
+};
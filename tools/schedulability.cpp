@@ -0,0 +1,187 @@
+/**
+ * @file schedulability.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Offline schedulability analysis of a task table.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/*  Bounds the response time of every task under the cooperative, non-preemptive
+*   model of Scheduler::run(), from the intervals and worst-case execution times of
+*   a task file (see TaskFile.hpp).
+*
+*   Once released, a task waits for the tasks run() dispatches before it:
+*   - linear, priority, wheel, bitmap and array dispatch visit each task once per pass, so
+*     a task released just after its visit waits for at most one run of every other
+*     task: the rest of the current pass and the start of the next one.
+*   - heap and edf dispatch can pick a short interval task several times per pass,
+*     so every other task is assumed to go first, once for the run in progress
+*     and once per release inside the wait:
+*         w = sum over j != i of (1 + floor(w / T_j)) * C_j
+*   The response time is the wait, plus the tick that detects the release when the
+*   interval is not a multiple of the system tick, plus the task's own run.
+*   Phase offsets are ignored: the bound holds for any phase.
+*/
+
+#include "TaskFile.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/* Exit code when a task can miss its deadline */
+static const int EXIT_UNSCHEDULABLE = 2;
+
+/* Iterations of the heap and edf recurrence before it is deemed divergent */
+static const int MAX_ITERATIONS = 1000;
+
+/* Longest wait of task [i] before it starts, negative when unbounded */
+static double waitTime(const std::vector<TaskSpec>& tasks, const std::vector<double>& wcet,
+                       const size_t i, const bool repeats)
+{
+    double wait = 0.0;
+    for( size_t j = 0; j < tasks.size(); ++j )
+    {
+        if( j != i )
+            wait += wcet[j];
+    }
+
+    if( !repeats )
+        return wait;
+
+    for( int iteration = 0; iteration < MAX_ITERATIONS; ++iteration )
+    {
+        double next = 0.0;
+        for( size_t j = 0; j < tasks.size(); ++j )
+        {
+            if( j != i )
+                next += (1.0 + std::floor(wait / (double)tasks[j].interval)) * wcet[j];
+        }
+
+        if( next == wait )
+            return wait;
+        wait = next;
+    }
+
+    return -1.0;
+}
+
+static void usage(const char* const name)
+{
+    std::printf("usage: %s [--mode M] [--systick US] tasks.txt\n", name);
+    std::printf("  --mode M     linear, priority, wheel, bitmap, array, heap or edf (default linear)\n");
+    std::printf("  --systick US System tick in microseconds (default 1)\n");
+    std::printf("exits with %d when a task can miss its deadline\n", EXIT_UNSCHEDULABLE);
+}
+
+int main(int argc, char** argv)
+{
+    const char* path = NULL;
+    const char* mode = "linear";
+    uint64_t systick_us = 1;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        if( std::strcmp(argv[i], "--mode") == 0 && i + 1 < argc )
+            mode = argv[++i];
+        else if( std::strcmp(argv[i], "--systick") == 0 && i + 1 < argc )
+            systick_us = std::strtoull(argv[++i], NULL, 10);
+        else if( path == NULL && argv[i][0] != '-' )
+            path = argv[i];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    const bool repeats = (std::strcmp(mode, "heap") == 0 || std::strcmp(mode, "edf") == 0);
+    const bool once = (std::strcmp(mode, "linear") == 0 || std::strcmp(mode, "priority") == 0 ||
+                       std::strcmp(mode, "wheel") == 0 || std::strcmp(mode, "bitmap") == 0 ||
+                       std::strcmp(mode, "array") == 0);
+    if( path == NULL || systick_us == 0 || (!repeats && !once) )
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<TaskSpec> tasks;
+    if( !loadTaskFile(path, tasks) )
+        return 1;
+
+    std::vector<double> wcet(tasks.size());
+    double utilization = 0.0;
+    for( size_t i = 0; i < tasks.size(); ++i )
+    {
+        if( tasks[i].interval == 0 )
+        {
+            std::fprintf(stderr, "%s: continuous tasks have no bound, use background tasks\n", tasks[i].name.c_str());
+            return 1;
+        }
+        if( !tasks[i].getWcet(wcet[i]) )
+        {
+            std::fprintf(stderr, "%s: a normal model needs a wcet key\n", tasks[i].name.c_str());
+            return 1;
+        }
+        utilization += wcet[i] / (double)tasks[i].interval;
+    }
+
+    std::printf("%-16s %10s %10s %8s %12s %12s %10s %s\n",
+                "task", "interval", "wcet_us", "util_%", "response_us", "jitter_us", "deadline", "verdict");
+
+    bool schedulable = (utilization <= 1.0);
+    for( size_t i = 0; i < tasks.size(); ++i )
+    {
+        const TaskSpec& task = tasks[i];
+        const uint64_t deadline = (task.deadline != 0) ? task.deadline : task.interval;
+        const double wait = waitTime(tasks, wcet, i, repeats);
+
+        if( wait < 0.0 )
+        {
+            std::printf("%-16s %10llu %10.3f %8.2f %12s %12s %10llu %s\n",
+                        task.name.c_str(), (unsigned long long)task.interval, wcet[i],
+                        100.0 * wcet[i] / task.interval, "unbounded", "unbounded",
+                        (unsigned long long)deadline, "MISS");
+            schedulable = false;
+            continue;
+        }
+
+        /* The release is seen on the first tick at or after it */
+        const uint64_t detection = (systick_us - task.interval % systick_us) % systick_us;
+        const double jitter = (double)detection + wait;
+        const double response = jitter + wcet[i];
+        const bool meets = (response <= (double)deadline);
+
+        std::printf("%-16s %10llu %10.3f %8.2f %12.3f %12.3f %10llu %s\n",
+                    task.name.c_str(), (unsigned long long)task.interval, wcet[i],
+                    100.0 * wcet[i] / task.interval, response, jitter,
+                    (unsigned long long)deadline, meets ? "ok" : "MISS");
+        schedulable = schedulable && meets;
+    }
+
+    std::printf("utilization %.2f%%, %s\n", 100.0 * utilization, schedulable ? "schedulable" : "NOT schedulable");
+    return schedulable ? 0 : EXIT_UNSCHEDULABLE;
+}
@@ -0,0 +1,305 @@
+/**
+ * @file simulator.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Deterministic discrete-event simulation of a task table on a virtual clock.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/*  Runs the real Scheduler against a virtual clock. Each task advances the clock by a
+*   modelled execution time, delivering the system ticks that would have interrupted
+*   it, and idle passes jump straight to the next release through the sleep handler,
+*   so hours of device time take milliseconds. The task file format is described in
+*   TaskFile.hpp, trace files are replayed in a loop.
+*/
+
+#include "Scheduler.hpp"
+#include "TaskFile.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+struct SimTask;
+
+/* Virtual clock shared by all tasks */
+struct SimClock {
+    Scheduler* scheduler;
+    uint64_t now_ns = 0;            /*!< Virtual time */
+    uint64_t ticks = 0;             /*!< System ticks delivered */
+    uint64_t tick_ns = 0;           /*!< Duration of a system tick */
+    uint64_t busy_ns = 0;           /*!< Time spent in tasks */
+    std::mt19937_64 rng;
+
+    /* Moves the clock, delivering the ticks that elapsed */
+    void advance(const uint64_t ns) {
+        now_ns += ns;
+        const uint64_t target = now_ns / tick_ns;
+        while( ticks < target )
+        {
+            const uint64_t step = (target - ticks > UINT32_MAX) ? UINT32_MAX : (target - ticks);
+            scheduler->advanceTicks((uint32_t)step);
+            ticks += step;
+        }
+    }
+};
+
+static SimClock sim_clock;
+
+struct SimTask {
+    TaskSpec spec;
+    size_t next_sample = 0;
+    uint64_t max_exec_ns = 0;
+    uint32_t deadline_misses = 0;
+    uint32_t budget_overruns = 0;
+
+    /* Draws the execution time of the next run */
+    uint64_t sample(void) {
+        double us = spec.a;
+        if( spec.model == EXEC_UNIFORM )
+            us = std::uniform_real_distribution<double>(spec.a, spec.b)(sim_clock.rng);
+        else if( spec.model == EXEC_NORMAL )
+            us = std::normal_distribution<double>(spec.a, spec.b)(sim_clock.rng);
+        else if( spec.model == EXEC_TRACE )
+        {
+            us = spec.samples[next_sample];
+            next_sample = (next_sample + 1) % spec.samples.size();
+        }
+        return (us <= 0.0) ? 0 : (uint64_t)(us * 1000.0);
+    }
+};
+
+/* Body of every simulated task */
+static void simTask(void* context)
+{
+    SimTask* const task = static_cast<SimTask*>(context);
+    const uint64_t exec_ns = task->sample();
+
+    if( exec_ns > task->max_exec_ns )
+        task->max_exec_ns = exec_ns;
+    sim_clock.busy_ns += exec_ns;
+    sim_clock.advance(exec_ns);
+}
+
+/* Runtimes in the statistics are in virtual nanoseconds */
+static uint32_t simCycles(void)
+{
+    return (uint32_t)sim_clock.now_ns;
+}
+
+/* Idle: jump to the next release */
+static void simSleep(const uint32_t ticks)
+{
+    const uint64_t next = (sim_clock.ticks + ((ticks == 0) ? 1 : ticks)) * sim_clock.tick_ns;
+    sim_clock.advance(next - sim_clock.now_ns);
+}
+
+static std::vector<SimTask>* sim_tasks = NULL;
+static std::vector<Scheduler::Task>* sim_table = NULL;
+
+static void simFault(Scheduler::Task& task, Scheduler::TimingFault fault)
+{
+    SimTask& sim_task = (*sim_tasks)[&task - sim_table->data()];
+    if( fault == Scheduler::FAULT_DEADLINE_MISS )
+        ++sim_task.deadline_misses;
+    else
+        ++sim_task.budget_overruns;
+}
+
+/* Builds the simulated tasks and the matching scheduler tasks */
+static bool loadTasks(const char* const path, std::vector<SimTask>& tasks, std::vector<Scheduler::Task>& table)
+{
+    std::vector<TaskSpec> specs;
+    if( !loadTaskFile(path, specs) )
+        return false;
+
+    tasks.resize(specs.size());
+    for( size_t i = 0; i < specs.size(); ++i )
+    {
+        tasks[i].spec = specs[i];
+
+        Scheduler::Task entry(simTask, &tasks[i], (Scheduler::tick_t)specs[i].interval);
+        entry.priority = specs[i].priority;
+        entry.deadline = (Scheduler::tick_t)specs[i].deadline;
+        entry.budget = (Scheduler::tick_t)specs[i].budget;
+        entry.phase = (Scheduler::tick_t)specs[i].phase;
+        table.push_back(entry);
+    }
+
+    return true;
+}
+
+static void usage(const char* const name)
+{
+    std::printf("usage: %s [options] tasks.txt\n", name);
+    std::printf("  --duration S     Simulated seconds (default 3600)\n");
+    std::printf("  --systick US     System tick in microseconds (default 1000)\n");
+    std::printf("  --mode M         linear, heap, wheel, priority, edf, bitmap or array (default linear)\n");
+    std::printf("  --policy P       free, skip, once or all (default free)\n");
+    std::printf("  --rate-monotonic Assign priorities from the intervals\n");
+    std::printf("  --auto-phase     Assign phase offsets that spread the releases\n");
+    std::printf("  --seed N         Seed of the execution time models (default 1)\n");
+}
+
+int main(int argc, char** argv)
+{
+    const char* path = NULL;
+    double duration_s = 3600.0;
+    uint32_t systick_us = 1000;
+    const char* mode = "linear";
+    const char* policy = "free";
+    bool rate_monotonic = false;
+    bool auto_phase = false;
+    unsigned long long seed = 1;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        if( std::strcmp(argv[i], "--duration") == 0 && i + 1 < argc )
+            duration_s = std::strtod(argv[++i], NULL);
+        else if( std::strcmp(argv[i], "--systick") == 0 && i + 1 < argc )
+            systick_us = (uint32_t)std::strtoul(argv[++i], NULL, 10);
+        else if( std::strcmp(argv[i], "--mode") == 0 && i + 1 < argc )
+            mode = argv[++i];
+        else if( std::strcmp(argv[i], "--policy") == 0 && i + 1 < argc )
+            policy = argv[++i];
+        else if( std::strcmp(argv[i], "--rate-monotonic") == 0 )
+            rate_monotonic = true;
+        else if( std::strcmp(argv[i], "--auto-phase") == 0 )
+            auto_phase = true;
+        else if( std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc )
+            seed = std::strtoull(argv[++i], NULL, 10);
+        else if( path == NULL && argv[i][0] != '-' )
+            path = argv[i];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if( path == NULL || systick_us == 0 || duration_s <= 0.0 )
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<SimTask> tasks;
+    std::vector<Scheduler::Task> table;
+    if( !loadTasks(path, tasks, table) )
+        return 1;
+    if( table.size() > UINT16_MAX )
+    {
+        std::fprintf(stderr, "too many tasks\n");
+        return 1;
+    }
+    const uint16_t num_tasks = (uint16_t)table.size();
+    sim_tasks = &tasks;
+    sim_table = &table;
+
+    Scheduler scheduler;
+    std::vector<Scheduler::DispatchEntry> queue(num_tasks);
+    std::vector<uint16_t> wheel_slots(SCHEDULER_WHEEL_LEVELS * Scheduler::WHEEL_SLOTS);
+    std::vector<uint16_t> wheel_links(num_tasks);
+    std::vector<uint16_t> order(num_tasks);
+    std::vector<uint32_t> released((num_tasks + 31) / 32);
+    std::vector<uint32_t> acknowledged((num_tasks + 31) / 32);
+    std::vector<uint32_t> scanned((num_tasks + 31) / 32);
+    std::vector<Scheduler::DispatchEntry> pending(num_tasks);
+    std::vector<Scheduler::tick_t> releases(num_tasks);
+
+    if( rate_monotonic )
+        Scheduler::assignRateMonotonicPriorities(table.data(), num_tasks);
+    if( auto_phase )
+        Scheduler::assignPhaseOffsets(table.data(), num_tasks, systick_us);
+
+    bool mode_valid = true;
+    if( std::strcmp(mode, "heap") == 0 )
+        scheduler.useHeapDispatch(queue.data(), num_tasks);
+    else if( std::strcmp(mode, "wheel") == 0 )
+        scheduler.useWheelDispatch(wheel_slots.data(), wheel_links.data(), num_tasks);
+    else if( std::strcmp(mode, "priority") == 0 )
+        scheduler.usePriorityDispatch(order.data(), num_tasks);
+    else if( std::strcmp(mode, "edf") == 0 )
+        scheduler.useEdfDispatch();
+    else if( std::strcmp(mode, "bitmap") == 0 )
+        scheduler.useBitmapDispatch(released.data(), acknowledged.data(), scanned.data(), (uint16_t)released.size(),
+                                    pending.data(), num_tasks);
+    else if( std::strcmp(mode, "array") == 0 )
+        scheduler.useReleaseArrayDispatch(releases.data(), num_tasks);
+    else
+        mode_valid = (std::strcmp(mode, "linear") == 0);
+
+    if( std::strcmp(policy, "skip") == 0 )
+        scheduler.setReleasePolicy(Scheduler::RELEASE_SKIP_MISSED);
+    else if( std::strcmp(policy, "once") == 0 )
+        scheduler.setReleasePolicy(Scheduler::RELEASE_RUN_ONCE);
+    else if( std::strcmp(policy, "all") == 0 )
+        scheduler.setReleasePolicy(Scheduler::RELEASE_RUN_ALL_MISSED);
+    else if( std::strcmp(policy, "free") != 0 )
+        mode_valid = false;
+
+    if( !mode_valid || !scheduler.init(table.data(), num_tasks, systick_us) )
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    sim_clock.scheduler = &scheduler;
+    sim_clock.tick_ns = (uint64_t)systick_us * 1000;
+    sim_clock.rng.seed(seed);
+    scheduler.setCycleCounter(simCycles);
+    scheduler.setSleepHandler(simSleep);
+    scheduler.setTimingFaultHandler(simFault);
+
+    const uint64_t end_ns = (uint64_t)(duration_s * 1e9);
+    while( sim_clock.now_ns < end_ns )
+    {
+        const uint64_t start_ns = sim_clock.now_ns;
+        scheduler.run();
+
+        /*  A pass that took no time, e.g. a continuous task of execution time 0,
+        *   lasts until the next system tick, so that the clock keeps moving.
+        */
+        if( sim_clock.now_ns == start_ns )
+            sim_clock.advance((sim_clock.ticks + 1) * sim_clock.tick_ns - sim_clock.now_ns);
+    }
+
+    std::printf("%-16s %10s %10s %12s %12s %12s %8s %8s\n",
+                "task", "interval", "runs", "avg_us", "max_us", "latency_us", "misses", "overruns");
+    for( uint16_t i = 0; i < num_tasks; ++i )
+    {
+        const Scheduler::TaskStats& stats = table[i].stats;
+        std::printf("%-16s %10llu %10u %12.3f %12.3f %12llu %8u %8u\n",
+                    tasks[i].spec.name.c_str(), (unsigned long long)table[i].interval, stats.run_count,
+                    stats.getAverageRuntime() / 1000.0, tasks[i].max_exec_ns / 1000.0,
+                    (unsigned long long)stats.max_jitter, tasks[i].deadline_misses, tasks[i].budget_overruns);
+    }
+
+    std::printf("simulated %.3f s, cpu load %.2f%%, deadline misses %u, budget overruns %u\n",
+                sim_clock.now_ns / 1e9, 100.0 * sim_clock.busy_ns / sim_clock.now_ns,
+                scheduler.getDeadlineMissCount(), scheduler.getBudgetOverrunCount());
+    return 0;
+}
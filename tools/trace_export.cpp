@@ -0,0 +1,130 @@
+/**
+ * @file trace_export.cpp
+ * @author Niel Cansino (nielcansino@gmail.com)
+ * @brief Host tool converting a binary scheduler trace to Chrome trace JSON.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/*  Reads the records written by Scheduler::copyTrace(), stored as raw little-endian
+*   TraceEvent structs, and streams them as Chrome trace JSON, which chrome://tracing
+*   and the Perfetto UI both open. The input is read in fixed chunks, so captures of
+*   any size convert in constant memory.
+*/
+
+#ifndef SCHEDULER_ENABLE_TRACE
+    #define SCHEDULER_ENABLE_TRACE
+#endif
+#include "TraceExporter.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/* Events read from the input at once */
+static const size_t CHUNK_EVENTS = 4096;
+
+static void usage(const char* const name)
+{
+    std::printf("usage: %s [--clock-hz N] [-o output.json] trace.bin|-\n", name);
+    std::printf("  --clock-hz   Counts per second of the trace timestamps (default 1000000)\n");
+}
+
+int main(int argc, char** argv)
+{
+    const char* input = NULL;
+    const char* output = NULL;
+    double clock_hz = 1000000.0;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        if( std::strcmp(argv[i], "--clock-hz") == 0 && i + 1 < argc )
+            clock_hz = std::strtod(argv[++i], NULL);
+        else if( std::strcmp(argv[i], "-o") == 0 && i + 1 < argc )
+            output = argv[++i];
+        else if( input == NULL && (argv[i][0] != '-' || argv[i][1] == '\0') )
+            input = argv[i];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if( input == NULL || clock_hz <= 0.0 )
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE* const in = (std::strcmp(input, "-") == 0) ? stdin : std::fopen(input, "rb");
+    if( in == NULL )
+    {
+        std::fprintf(stderr, "cannot open %s\n", input);
+        return 1;
+    }
+
+    FILE* const out = (output == NULL) ? stdout : std::fopen(output, "w");
+    if( out == NULL )
+    {
+        std::fprintf(stderr, "cannot create %s\n", output);
+        return 1;
+    }
+
+    TraceExporter exporter(out, 1000000.0 / clock_hz);
+    static uint8_t chunk[CHUNK_EVENTS * sizeof(TraceEvent)];
+    unsigned long count = 0;
+    size_t pending = 0;
+
+    exporter.begin();
+    for( ;; )
+    {
+        const size_t read = std::fread(chunk + pending, 1, sizeof(chunk) - pending, in);
+        if( read == 0 )
+            break;
+
+        /* A record may straddle two reads from a pipe */
+        const size_t available = pending + read;
+        const size_t records = available / sizeof(TraceEvent);
+        for( size_t i = 0; i < records; ++i )
+            exporter.event(chunk + i * sizeof(TraceEvent));
+
+        pending = available - records * sizeof(TraceEvent);
+        std::memmove(chunk, chunk + records * sizeof(TraceEvent), pending);
+        count += records;
+    }
+    exporter.finish();
+
+    if( pending != 0 )
+        std::fprintf(stderr, "ignored %u trailing bytes\n", (unsigned)pending);
+    if( exporter.getUnknownCount() != 0 )
+        std::fprintf(stderr, "ignored %lu events of unknown type\n", exporter.getUnknownCount());
+    std::fprintf(stderr, "%lu events\n", count);
+
+    if( in != stdin )
+        std::fclose(in);
+    if( out != stdout )
+        std::fclose(out);
+    return 0;
+}